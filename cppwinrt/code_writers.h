@@ -38,7 +38,7 @@ namespace cppwinrt
     static void write_version_assert(writer& w)
     {
         w.write_root_include("base");
-        auto format = R"(static_assert(winrt::check_version(CPPWINRT_VERSION, "%"), "Mismatched C++/WinRT headers.");
+        static constexpr char format[] = R"(static_assert(winrt::check_version(CPPWINRT_VERSION, "%"), "Mismatched C++/WinRT headers.");
 #define CPPWINRT_VERSION "%"
 )";
         w.write(format, CPPWINRT_VERSION_STRING, CPPWINRT_VERSION_STRING);
@@ -46,7 +46,7 @@ namespace cppwinrt
 
     static void write_include_guard(writer& w)
     {
-        auto format = R"(#pragma once
+        static constexpr char format[] = R"(#pragma once
 )";
 
         w.write(format);
@@ -54,7 +54,7 @@ namespace cppwinrt
 
     static void write_endif(writer& w)
     {
-        auto format = R"(#endif
+        static constexpr char format[] = R"(#endif
 )";
 
         w.write(format);
@@ -82,7 +82,7 @@ namespace cppwinrt
             mangled_name += impl;
         }
 
-        auto format = R"(#ifndef WINRT_%_H
+        static constexpr char format[] = R"(#ifndef WINRT_%_H
 #define WINRT_%_H
 )";
 
@@ -100,7 +100,7 @@ namespace cppwinrt
     {
         if (is_lean_and_mean)
         {
-            auto format = R"(#ifndef WINRT_LEAN_AND_MEAN
+            static constexpr char format[] = R"(#ifndef WINRT_LEAN_AND_MEAN
 )";
 
             w.write(format);
@@ -115,7 +115,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_ifdef(writer& w, std::string_view macro)
     {
-        auto format = R"(#ifdef %
+        static constexpr char format[] = R"(#ifdef %
 )";
 
         w.write(format, macro);
@@ -147,7 +147,7 @@ namespace cppwinrt
 
     static void write_pch(writer& w)
     {
-        auto format = R"(#include "%"
+        static constexpr char format[] = R"(#include "%"
 )";
 
         if (!settings.component_pch.empty())
@@ -158,7 +158,7 @@ namespace cppwinrt
 
     static void write_close_namespace(writer& w)
     {
-        auto format = R"(}
+        static constexpr char format[] = R"(}
 )";
 
         w.write(format);
@@ -166,7 +166,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_impl_namespace(writer& w)
     {
-        auto format = R"(namespace winrt::impl
+        static constexpr char format[] = R"(namespace winrt::impl
 {
 )";
 
@@ -186,7 +186,7 @@ namespace cppwinrt
 
     [[nodiscard]] static finish_with wrap_type_namespace(writer& w, std::string_view const& ns)
     {
-        auto format = R"(WINRT_EXPORT namespace winrt::@
+        static constexpr char format[] = R"(WINRT_EXPORT namespace winrt::@
 {
 )";
 
@@ -197,7 +197,7 @@ namespace cppwinrt
 
     static void write_enum_field(writer& w, Field const& field)
     {
-        auto format = R"(        % = %,
+        static constexpr char format[] = R"(        % = %,
 )";
 
         if (auto constant = field.Constant())
@@ -208,7 +208,7 @@ namespace cppwinrt
 
     static void write_enum(writer& w, TypeDef const& type)
     {
-        auto format = R"(    enum class % : %
+        static constexpr char format[] = R"(    enum class % : %
     {
 %    };
 )";
@@ -226,7 +226,7 @@ namespace cppwinrt
 
         auto name = type.TypeName();
 
-        auto format = R"(    constexpr auto operator|(% const left, % const right) noexcept
+        static constexpr char format[] = R"(    constexpr auto operator|(% const left, % const right) noexcept
     {
         return static_cast<%>(impl::to_underlying_type(left) | impl::to_underlying_type(right));
     }
@@ -277,7 +277,7 @@ namespace cppwinrt
     {
         for (auto&& param : params)
         {
-            auto format = R"(
+            static constexpr char format[] = R"(
         static_assert(impl::has_category_v<%>, "% must be WinRT type.");)";
 
             w.write(format, param, param);
@@ -306,7 +306,7 @@ namespace cppwinrt
 
         if (get_category(type) == category::enum_type)
         {
-            auto format = R"(    enum class % : %;
+            static constexpr char format[] = R"(    enum class % : %;
 )";
 
             w.write(format, type_name.name, type.FieldList().first.Signature().Type());
@@ -339,14 +339,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    struct %;
+            static constexpr char format[] = R"(    struct %;
 )";
 
             w.write(format, type_name.name);
             return;
         }
 
-        auto format = R"(    template <%> struct WINRT_IMPL_EMPTY_BASES %;
+        static constexpr char format[] = R"(    template <%> struct WINRT_IMPL_EMPTY_BASES %;
 )";
 
         w.write(format,
@@ -396,14 +396,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> struct category<%>{ using type = %; };
+            static constexpr char format[] = R"(    template <> struct category<%>{ using type = %; };
 )";
 
             w.write(format, type, category);
         }
         else
         {
-            auto format = R"(    template <%> struct category<%>{ using type = generic_category<%>; };
+            static constexpr char format[] = R"(    template <%> struct category<%>{ using type = generic_category<%>; };
 )";
 
             w.write(format,
@@ -438,14 +438,14 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> inline constexpr auto& name_v<%> = L"%.%";
+            static constexpr char format[] = R"(    template <> inline constexpr auto& name_v<%> = L"%.%";
 )";
 
             w.write(format, type, type_name.name_space, type_name.name);
         }
         else
         {
-            auto format = R"(    template <%> inline constexpr auto name_v<%> = zcombine(L"%.%<"%, L">");
+            static constexpr char format[] = R"(    template <%> inline constexpr auto name_v<%> = zcombine(L"%.%<"%, L">");
 )";
 
             w.write(format,
@@ -471,7 +471,7 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> inline constexpr guid guid_v<%>{ % }; // %
+            static constexpr char format[] = R"(    template <> inline constexpr guid guid_v<%>{ % }; // %
 )";
 
             w.write(format,
@@ -481,7 +481,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(    template <%> inline constexpr guid guid_v<%>{ pinterface_guid<%>::value };
+            static constexpr char format[] = R"(    template <%> inline constexpr guid guid_v<%>{ pinterface_guid<%>::value };
     template <%> inline constexpr guid generic_guid_v<%>{ % }; // %
 )";
 
@@ -500,7 +500,7 @@ namespace cppwinrt
     {
         if (auto default_interface = get_default_interface(type))
         {
-            auto format = R"(    template <> struct default_interface<%>{ using type = %; };
+            static constexpr char format[] = R"(    template <> struct default_interface<%>{ using type = %; };
 )";
             w.write(format, type, default_interface);
         }
@@ -508,7 +508,7 @@ namespace cppwinrt
 
     static void write_struct_category(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <> struct category<%>{ using type = struct_category<%>; };
+        static constexpr char format[] = R"(    template <> struct category<%>{ using type = struct_category<%>; };
 )";
 
         w.write(format, type, bind_list(", ", type.FieldList()));
@@ -725,7 +725,7 @@ namespace cppwinrt
 
         std::for_each(bases.rbegin(), bases.rend(), [&](auto&& base)
         {
-            auto format = R"(            virtual void* __stdcall base_%() noexcept = 0;
+            static constexpr char format[] = R"(            virtual void* __stdcall base_%() noexcept = 0;
 )";
 
             w.write(format, base.TypeName());
@@ -743,7 +743,7 @@ namespace cppwinrt
                 break;
             }
 
-            auto format = R"(            virtual int32_t __stdcall %(%) noexcept = 0;
+            static constexpr char format[] = R"(            virtual int32_t __stdcall %(%) noexcept = 0;
 )";
 
             for (auto&& method : info.type.MethodList())
@@ -761,7 +761,7 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <> struct abi<%>
+            static constexpr char format[] = R"(    template <> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : inspectable_abi
         {
@@ -771,7 +771,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(    template <%> struct abi<%>
+            static constexpr char format[] = R"(    template <%> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : inspectable_abi
         {
@@ -783,7 +783,7 @@ namespace cppwinrt
         }
 
 
-        auto format = R"(            virtual int32_t __stdcall %(%) noexcept = 0;
+        static constexpr char format[] = R"(            virtual int32_t __stdcall %(%) noexcept = 0;
 )";
 
         auto abi_guard = w.push_abi_types(true);
@@ -812,7 +812,7 @@ namespace cppwinrt
 
     static void write_delegate_abi(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <%> struct abi<%>
+        static constexpr char format[] = R"(    template <%> struct abi<%>
     {
         struct WINRT_IMPL_ABI_DECL type : unknown_abi
         {
@@ -841,7 +841,7 @@ namespace cppwinrt
     {
         auto abi_guard = w.push_abi_types(true);
 
-        auto format = R"(    struct struct_%
+        static constexpr char format[] = R"(    struct struct_%
     {
 %    };
     template <> struct abi<@::%>
@@ -998,7 +998,7 @@ namespace cppwinrt
 
         if (is_add_overload(method))
         {
-            auto format = R"(        using %_revoker = impl::event_revoker<%, &impl::abi_t<%>::remove_%>;
+            static constexpr char format[] = R"(        using %_revoker = impl::event_revoker<%, &impl::abi_t<%>::remove_%>;
         [[nodiscard]] auto %(auto_revoke_t, %) const;
 )";
 
@@ -1048,7 +1048,7 @@ namespace cppwinrt
 
         if (category == param_category::array_type)
         {
-            auto format = R"(
+            static constexpr char format[] = R"(
         uint32_t %_impl_size{};
         %* %{};)";
 
@@ -1062,17 +1062,17 @@ namespace cppwinrt
         }
         else if (category == param_category::object_type || category == param_category::string_type)
         {
-            auto format = "\n        void* %{};";
+            static constexpr char format[] = "\n        void* %{};";
             w.write(format, signature.return_param_name());
         }
         else if (category == param_category::generic_type)
         {
-            auto format = "\n        % %{ empty_value<%>() };";
+            static constexpr char format[] = "\n        % %{ empty_value<%>() };";
             w.write(format, signature.return_signature(), signature.return_param_name(), signature.return_signature());
         }
         else
         {
-            auto format = "\n        % %{};";
+            static constexpr char format[] = "\n        % %{};";
             w.write(format, signature.return_signature(), signature.return_param_name());
         }
     }
@@ -1574,7 +1574,7 @@ namespace cppwinrt
 
         if (empty(generics))
         {
-            auto format = R"(    template <typename D>
+            static constexpr char format[] = R"(    template <typename D>
     struct consume_%
     {
 %%%    };
@@ -1595,7 +1595,7 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(    template <typename D, %>
+            static constexpr char format[] = R"(    template <typename D, %>
     struct consume_%
     {
 %%%    };
@@ -1699,7 +1699,7 @@ namespace cppwinrt
 
         if (clear)
         {
-            auto format = R"(            clear_abi(%);
+            static constexpr char format[] = R"(            clear_abi(%);
 )";
 
             w.write(format, param_name);
@@ -1708,7 +1708,7 @@ namespace cppwinrt
         {
             if (signature.is_szarray())
             {
-                auto format = R"(            zero_abi<%>(%, __%Size);
+                static constexpr char format[] = R"(            zero_abi<%>(%, __%Size);
 )";
 
                 w.write(format,
@@ -1718,7 +1718,7 @@ namespace cppwinrt
             }
             else
             {
-                auto format = R"(            zero_abi<%>(%);
+                static constexpr char format[] = R"(            zero_abi<%>(%);
 )";
 
                 w.write(format,
@@ -1728,7 +1728,7 @@ namespace cppwinrt
         }
         else if (optional)
         {
-            auto format = R"(            if (%) *% = nullptr;
+            static constexpr char format[] = R"(            if (%) *% = nullptr;
             winrt::Windows::Foundation::IInspectable winrt_impl_%;
 )";
 
@@ -1929,7 +1929,7 @@ namespace cppwinrt
 
         std::for_each(bases.rbegin(), bases.rend(), [&](auto && base)
         {
-            auto format = R"(        void* __stdcall base_%() noexcept final
+            static constexpr char format[] = R"(        void* __stdcall base_%() noexcept final
         {
             return this->shim().base_%();
         }
@@ -1957,7 +1957,7 @@ namespace cppwinrt
 
     static void write_produce(writer& w, TypeDef const& type, cache const& c)
     {
-        auto format = R"(    template <typename D%>
+        static constexpr char format[] = R"(    template <typename D%>
     struct produce<D, %> : produce_base<D, %>
     {
 %%    };
@@ -1979,7 +1979,7 @@ namespace cppwinrt
 
     static void write_dispatch_overridable_method(writer& w, MethodDef const& method)
     {
-        auto format = R"(    auto %(%)%
+        static constexpr char format[] = R"(    auto %(%)%
     {
         if (auto overridable = this->shim_overridable())
         {
@@ -2004,7 +2004,7 @@ namespace cppwinrt
 
     static void write_dispatch_overridable(writer& w, TypeDef const& class_type)
     {
-        auto format = R"(template <typename T, typename D>
+        static constexpr char format[] = R"(template <typename T, typename D>
 struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     : produce_dispatch_to_overridable_base<T, D, %>
 {
@@ -2025,7 +2025,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_interface_override_method(writer& w, MethodDef const& method, std::string_view const& interface_name)
     {
-        auto format = R"(    template <typename D> auto %T<D>::%(%) const%
+        static constexpr char format[] = R"(    template <typename D> auto %T<D>::%(%) const%
     {
         return shim().template try_as<%>().%(%);
     }
@@ -2173,7 +2173,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             factory_name = w.write_temp("%", factory);
         }
 
-        auto format = "impl::call_factory<%, %>([&](% const& f)";
+        static constexpr char format[] = "impl::call_factory<%, %>([&](% const& f)";
 
         w.write(format,
             type.TypeName(),
@@ -2196,7 +2196,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (signature.params().empty())
         {
-            auto format = "impl::call_factory_cast<%(*)(% const&), %, %>([](% const& f) { return f.%(); })";
+            static constexpr char format[] = "impl::call_factory_cast<%(*)(% const&), %, %>([](% const& f) { return f.%(); })";
 
             w.write(format,
                 signature.return_signature(),
@@ -2208,7 +2208,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         }
         else
         {
-            auto format = "impl::call_factory<%, %>([&](% const& f) { return f.%(%); })";
+            static constexpr char format[] = "impl::call_factory<%, %>([&](% const& f) { return f.%(%); })";
 
             w.write(format,
                 type.TypeName(),
@@ -2223,7 +2223,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     {
         auto type_name = type.TypeName();
 
-        auto format = R"(        %T(%)
+        static constexpr char format[] = R"(        %T(%)
         {
             % { [[maybe_unused]] auto winrt_impl_discarded = f.%(%%*this, this->m_inner); });
         }
@@ -2255,7 +2255,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_interface_override(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <typename D>
+        static constexpr char format[] = R"(    template <typename D>
     class %T
     {
         D& shim() noexcept { return *static_cast<D*>(this); }
@@ -2329,7 +2329,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             return;
         }
 
-        auto format = R"(    template <typename D, typename... Interfaces>
+        static constexpr char format[] = R"(    template <typename D, typename... Interfaces>
     struct %T :
         implements<D%, composing, Interfaces...>,
         impl::require<D%>%,
@@ -2470,7 +2470,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (empty(generics))
         {
-            auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % :
+            static constexpr char format[] = R"(    struct WINRT_IMPL_EMPTY_BASES % :
         winrt::Windows::Foundation::IInspectable,
         impl::consume_t<%>%
     {
@@ -2492,7 +2492,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         {
             type_name = remove_tick(type_name);
 
-            auto format = R"(    template <%>
+            static constexpr char format[] = R"(    template <%>
     struct WINRT_IMPL_EMPTY_BASES % :
         winrt::Windows::Foundation::IInspectable,
         impl::consume_t<%>%
@@ -2525,13 +2525,13 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         {
             type_name = remove_tick(type_name);
 
-            auto format = R"(    template <%>
+            static constexpr char format[] = R"(    template <%>
 )";
 
             w.write(format, bind<write_generic_typenames>(generics));
         }
 
-        auto format = R"(    struct % : winrt::Windows::Foundation::IUnknown
+        static constexpr char format[] = R"(    struct % : winrt::Windows::Foundation::IUnknown
     {%
         %(std::nullptr_t = nullptr) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : winrt::Windows::Foundation::IUnknown(ptr, take_ownership_from_abi) {}
@@ -2565,7 +2565,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
     static void write_delegate_implementation(writer& w, TypeDef const& type)
     {
-        auto format = R"(    template <typename H%> struct delegate<%, H> final : implements_delegate<%, H>
+        static constexpr char format[] = R"(    template <typename H%> struct delegate<%, H> final : implements_delegate<%, H>
     {
         delegate(H&& handler) : implements_delegate<%, H>(std::forward<H>(handler)) {}
 
@@ -2601,7 +2601,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (!empty(generics))
         {
-            auto format = R"(    template <%> template <typename L> %<%>::%(L handler) :
+            static constexpr char format[] = R"(    template <%> template <typename L> %<%>::%(L handler) :
         %(impl::make_delegate<%<%>>(std::forward<L>(handler)))
     {
     }
@@ -2693,7 +2693,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         }
         else
         {
-            auto format = R"(    template <typename L> %::%(L handler) :
+            static constexpr char format[] = R"(    template <typename L> %::%(L handler) :
         %(impl::make_delegate<%>(std::forward<L>(handler)))
     {
     }
@@ -2785,9 +2785,16 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         }
     }
 
+    // A struct field whose type is projected outside the struct's namespace needs that type to be complete, so the
+    // impl/%.2.h header includes the impl/%.2.h headers of its dependencies rather than impl/%.1.h.
+    static bool is_promoted_field(std::string_view const& cpp_namespace, std::string_view const& field_type)
+    {
+        return field_type.find(':') != std::string_view::npos && !starts_with(field_type, cpp_namespace);
+    }
+
     static bool write_structs(writer& w, std::vector<TypeDef> const& types)
     {
-        auto format = R"(    struct %
+        static constexpr char format[] = R"(    struct %
     {
 %    };
     inline bool operator==(% const& left, % const& right)%
@@ -2889,21 +2896,45 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
             for (auto&& field : type.fields)
             {
-                if (field.second.find(':') == std::string::npos)
-                {
-                    continue;
-                }
-
-                if (!starts_with(field.second, cpp_namespace))
-                {
-                    promote = true;
-                }
+                promote = promote || is_promoted_field(cpp_namespace, field.second);
             }
         }
 
         return promote;
     }
 
+    // Returns the namespaces whose impl/%.2.h headers the impl/%.2.h header of the given namespace is certain to
+    // include, computed from the metadata without writing the header. These are the namespaces of the struct fields
+    // when a field is promoted (see write_structs). The header's other dependencies are only found while writing it,
+    // so they are left out.
+    static std::set<std::string_view> get_promoted_depends(std::string_view const& ns, std::vector<TypeDef> const& types)
+    {
+        writer w;
+        w.type_namespace = ns;
+        auto cpp_namespace = w.write_temp("@", ns);
+        bool promote = false;
+
+        for (auto&& type : types)
+        {
+            for (auto&& field : type.FieldList())
+            {
+                promote = is_promoted_field(cpp_namespace, w.write_temp("%", field.Signature().Type())) || promote;
+            }
+        }
+
+        std::set<std::string_view> result;
+
+        if (promote)
+        {
+            for (auto&& depends : w.depends)
+            {
+                result.insert(depends.first);
+            }
+        }
+
+        return result;
+    }
+
     static void write_class_requires(writer& w, TypeDef const& type)
     {
         bool first = true;
@@ -2977,7 +3008,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
     {
         for (auto&& base : get_bases(type))
         {
-            auto format = R"(        operator impl::producer_ref<%> const() const noexcept;
+            static constexpr char format[] = R"(        operator impl::producer_ref<%> const() const noexcept;
 )";
 
             w.write(format, base);
@@ -3003,7 +3034,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         for (auto&& base : get_bases(type))
         {
-            auto format = R"(    inline %::operator impl::producer_ref<%> const() const noexcept
+            static constexpr char format[] = R"(    inline %::operator impl::producer_ref<%> const() const noexcept
     {
         return { (*(impl::abi_t<%>**)this)->base_%() };
     }
@@ -3070,7 +3101,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         method_signature signature{ method };
 
-        auto format = R"(    inline %::%(%) :
+        static constexpr char format[] = R"(    inline %::%(%) :
         %(%)
     {
     }
@@ -3094,7 +3125,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto base_param = params.back().first.Name();
         params.pop_back();
 
-        auto format = R"(    inline %::%(%)
+        static constexpr char format[] = R"(    inline %::%(%)
     {
         winrt::Windows::Foundation::IInspectable %, %;
         *this = % { return f.%(%%%, %); });
@@ -3150,7 +3181,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
             if (is_add_overload(method))
             {
                 {
-                    auto format = R"(        using %_revoker = impl::factory_event_revoker<%, &impl::abi_t<%>::remove_%>;
+                    static constexpr char format[] = R"(        using %_revoker = impl::factory_event_revoker<%, &impl::abi_t<%>::remove_%>;
 )";
                     w.write(format,
                         method_name,
@@ -3161,7 +3192,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
                 if (is_opt_type)
                 {
-                    auto format = R"(        [[nodiscard]] static %_revoker %(auto_revoke_t, %);
+                    static constexpr char format[] = R"(        [[nodiscard]] static %_revoker %(auto_revoke_t, %);
 )";
                     w.write(format,
                         method_name,
@@ -3170,7 +3201,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
                 }
                 else
                 {
-                    auto format = R"(        [[nodiscard]] static auto %(auto_revoke_t, %);
+                    static constexpr char format[] = R"(        [[nodiscard]] static auto %(auto_revoke_t, %);
 )";
                     w.write(format,
                         method_name,
@@ -3188,7 +3219,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto async_types_guard = w.push_async_types(signature.is_async());
 
         {
-            auto format = R"(    inline auto %::%(%)
+            static constexpr char format[] = R"(    inline auto %::%(%)
     {
         %%;
     }
@@ -3204,7 +3235,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
 
         if (is_add_overload(method))
         {
-            auto format = R"(    inline auto %::%(auto_revoke_t, %)
+            static constexpr char format[] = R"(    inline auto %::%(auto_revoke_t, %)
     {
         auto f = get_activation_factory<%, %>();
         return %::%_revoker{ f, f.%(%) };
@@ -3287,7 +3318,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%%
+        static constexpr char format[] = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%%
     {
         %(std::nullptr_t) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : %(ptr, take_ownership_from_abi) {}
@@ -3312,7 +3343,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%
+        static constexpr char format[] = R"(    struct WINRT_IMPL_EMPTY_BASES % : %%
     {
         %(std::nullptr_t) noexcept {}
         %(void* ptr, take_ownership_from_abi_t) noexcept : %(ptr, take_ownership_from_abi) {}
@@ -3336,7 +3367,7 @@ struct WINRT_IMPL_EMPTY_BASES produce_dispatch_to_overridable<T, D, %>
         auto type_name = type.TypeName();
         auto factories = get_factories(w, type);
 
-        auto format = R"(    struct %
+        static constexpr char format[] = R"(    struct %
     {
         %() = delete;
 %    };
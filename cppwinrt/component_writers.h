@@ -78,14 +78,14 @@ namespace cppwinrt
 
         if (settings.component_opt)
         {
-            auto format = R"(void* winrt_make_%();
+            static constexpr char format[] = R"(void* winrt_make_%();
 )";
 
             w.write(format, get_impl_name(type.TypeNamespace(), type.TypeName()));
         }
         else
         {
-            auto format = R"(#include "%.h"
+            static constexpr char format[] = R"(#include "%.h"
 )";
 
             w.write(format, get_component_filename(type));
@@ -94,22 +94,16 @@ namespace cppwinrt
 
     static void write_component_activation(writer& w, TypeDef const& type)
     {
-        if (!has_factory_members(w, type) || is_always_disabled(type))
-        {
-            return;
-        }
-
         auto type_name = type.TypeName();
         auto type_namespace = type.TypeNamespace();
         auto impl_name = get_impl_name(type_namespace, type_name);
 
         if (settings.component_opt)
         {
-            auto format = R"(
-    if (requal(name, L"%.%"))
-    {
-        return winrt_make_%();
-    }
+            static constexpr char format[] = R"(        if (requal(name, L"%.%"))
+        {
+            return winrt_make_%();
+        }
 )";
 
             w.write(format,
@@ -119,11 +113,10 @@ namespace cppwinrt
         }
         else
         {
-            auto format = R"(
-    if (requal(name, L"%.%"))
-    {
-        return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
-    }
+            static constexpr char format[] = R"(        if (requal(name, L"%.%"))
+        {
+            return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
+        }
 )";
 
             w.write(format,
@@ -134,10 +127,68 @@ namespace cppwinrt
         }
     }
 
+    // Returns the length of a metadata name once it is written as a wide string literal.
+    static uint32_t get_utf16_length(std::string_view const& value)
+    {
+        uint32_t length{};
+
+        for (auto&& c : value)
+        {
+            auto const byte = static_cast<uint8_t>(c);
+
+            if ((byte & 0xC0) != 0x80)
+            {
+                // Code points that take four bytes in UTF-8 take a surrogate pair in UTF-16.
+                length += byte >= 0xF0 ? 2 : 1;
+            }
+        }
+
+        return length;
+    }
+
+    static void write_component_activations(writer& w, std::vector<TypeDef> const& classes)
+    {
+        // The classes are bucketed by the length of their names so that activation only compares the requested
+        // name with the names that have the same length, rather than with every name in the component.
+        std::map<uint32_t, std::vector<TypeDef>> buckets;
+
+        for (auto&& type : classes)
+        {
+            if (has_factory_members(w, type) && !is_always_disabled(type))
+            {
+                buckets[get_utf16_length(type.TypeNamespace()) + 1 + get_utf16_length(type.TypeName())].push_back(type);
+            }
+        }
+
+        if (buckets.empty())
+        {
+            return;
+        }
+
+        w.write(R"(
+    switch (name.size())
+    {
+)");
+
+        for (auto&&[length, types] : buckets)
+        {
+            static constexpr char format[] = R"(    case %:
+%        break;
+)";
+
+            w.write(format,
+                length,
+                bind_each<write_component_activation>(types));
+        }
+
+        w.write(R"(    }
+)");
+    }
+
     static void write_module_g_cpp(writer& w, std::vector<TypeDef> const& classes)
     {
         w.write_root_include("base");
-        auto format = R"(%
+        static constexpr char format[] = R"(%
 bool __stdcall %_can_unload_now() noexcept
 {
     if (winrt::get_module_lock())
@@ -164,14 +215,14 @@ void* __stdcall %_get_activation_factory([[maybe_unused]] std::wstring_view cons
             bind_each<write_component_include>(classes),
             settings.component_lib,
             settings.component_lib,
-            bind_each<write_component_activation>(classes));
+            bind<write_component_activations>(classes));
 
         if (settings.component_lib != "winrt")
         {
             return;
         }
 
-        format = R"(
+        static constexpr char exports_format[] = R"(
 int32_t __stdcall WINRT_CanUnloadNow() noexcept
 {
 #ifdef _WRL_MODULE_H_
@@ -207,7 +258,7 @@ int32_t __stdcall WINRT_GetActivationFactory(void* classId, void** factory) noex
 catch (...) { return winrt::to_hresult(); }
 )";
 
-        w.write(format,
+        w.write(exports_format,
             settings.component_lib,
             settings.component_lib);
     }
@@ -257,7 +308,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_composable_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        static constexpr char format[] = R"(        auto %(%)
         {
             return impl::composable_factory<T>::template CreateInstance<%>(%);
         }
@@ -278,7 +329,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_constructor_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        static constexpr char format[] = R"(        auto %(%)
         {
             return make<T>(%);
         }
@@ -295,7 +346,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_static_forwarder(writer& w, MethodDef const& method)
     {
-        auto format = R"(        auto %(%)
+        static constexpr char format[] = R"(        auto %(%)
         {
             return T::%(%);
         }
@@ -380,7 +431,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(void* winrt_make_%()
+            static constexpr char format[] = R"(void* winrt_make_%()
 {
     return winrt::detach_abi(winrt::make<winrt::@::factory_implementation::%>());
 }
@@ -410,7 +461,7 @@ catch (...) { return winrt::to_hresult(); }
             {
                 if (!factory.type)
                 {
-                    auto format = R"(    %::%() :
+                    static constexpr char format[] = R"(    %::%() :
         %(make<@::implementation::%>())
     {
     }
@@ -429,7 +480,7 @@ catch (...) { return winrt::to_hresult(); }
                     {
                         method_signature signature{ method };
 
-                        auto format = R"(    %::%(%) :
+                        static constexpr char format[] = R"(    %::%(%) :
         %(make<@::implementation::%>(%))
     {
     }
@@ -454,7 +505,7 @@ catch (...) { return winrt::to_hresult(); }
                     auto& params = signature.params();
                     params.resize(params.size() - 2);
 
-                    auto format = R"(    %::%(%) :
+                    static constexpr char format[] = R"(    %::%(%) :
         %(make<@::implementation::%>(%))
     {
     }
@@ -480,7 +531,7 @@ catch (...) { return winrt::to_hresult(); }
 
                     if (is_add_overload(method) || is_remove_overload(method))
                     {
-                        auto format = R"(    % %::%(%)
+                        static constexpr char format[] = R"(    % %::%(%)
     {
         auto f = make<winrt::@::factory_implementation::%>().as<%>();
         return f.%(%);
@@ -500,7 +551,7 @@ catch (...) { return winrt::to_hresult(); }
                     }
                     else
                     {
-                        auto format = R"(    % %::%(%)
+                        static constexpr char format[] = R"(    % %::%(%)
     {
         %@::implementation::%::%(%);
     }
@@ -522,7 +573,7 @@ catch (...) { return winrt::to_hresult(); }
 
                     if (is_add_overload(method))
                     {
-                        auto format = R"(    %::%_revoker %::%(auto_revoke_t, %)
+                        static constexpr char format[] = R"(    %::%_revoker %::%(auto_revoke_t, %)
     {
         auto f = make<winrt::@::factory_implementation::%>().as<%>();
         return %::%_revoker{ f, f.%(%) };
@@ -573,7 +624,7 @@ catch (...) { return winrt::to_hresult(); }
             return;
         }
 
-        auto format = R"(
+        static constexpr char format[] = R"(
     protected:
         using dispatch = impl::dispatch_to_overridable<D@>;
         auto overridable() noexcept { return dispatch::overridable(static_cast<D&>(*this)); }
@@ -611,7 +662,7 @@ catch (...) { return winrt::to_hresult(); }
                 auto& params = signature.params();
                 params.resize(params.size() - 2);
 
-                auto format = R"(        %_base(%)
+                static constexpr char format[] = R"(        %_base(%)
         {
             impl::call_factory<%, %>([&](% const& f) { [[maybe_unused]] auto winrt_impl_discarded = f.%(%%*this, this->m_inner); });
         }
@@ -632,7 +683,7 @@ catch (...) { return winrt::to_hresult(); }
 
     static void write_component_tearoff_interfaces(writer& w, TypeDef const& type)
     {
-        auto format = R"(
+        static constexpr char format[] = R"(
             if (is_guid_of<%>(id))
             {
                 *result = make_fast_abi_forwarder(static_cast<D const&>(*this).template get_abi<class_type>(), guid_of<%>(), %);
@@ -684,7 +735,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_base)
         {
-            auto format = R"(
+            static constexpr char format[] = R"(
         int32_t query_interface_tearoff(guid const& id, void** result) const noexcept override
         {%
             return B::query_interface_tearoff(id, result);
@@ -700,7 +751,7 @@ catch (...) { return winrt::to_hresult(); }
                 return;
             }
 
-            auto format = R"(
+            static constexpr char format[] = R"(
         int32_t query_interface_tearoff(guid const& id, void** result) const noexcept override
         {%
             return impl::error_no_interface;
@@ -725,7 +776,7 @@ catch (...) { return winrt::to_hresult(); }
             return;
         }
 
-        auto format = R"(
+        static constexpr char format[] = R"(
         auto base_%() const noexcept
         {
             return static_cast<D const&>(*this).template get_abi<%>();
@@ -744,7 +795,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (non_static)
         {
-            auto format = R"(namespace winrt::@::implementation
+            static constexpr char format[] = R"(namespace winrt::@::implementation
 {
     template <typename D%, typename... I>
     struct WINRT_IMPL_EMPTY_BASES %_base : implements<D, @::%%%, %I...>%%%%
@@ -868,7 +919,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(namespace winrt::@::factory_implementation
+            static constexpr char format[] = R"(namespace winrt::@::factory_implementation
 {
     template <typename D, typename T, typename... I>
     struct WINRT_IMPL_EMPTY_BASES %T : implements<D, winrt::Windows::Foundation::IActivationFactory%, I...>
@@ -896,7 +947,7 @@ catch (...) { return winrt::to_hresult(); }
 
         if (non_static)
         {
-            auto format = R"(
+            static constexpr char format[] = R"(
 #if defined(WINRT_FORCE_INCLUDE_%_XAML_G_H) || __has_include("%.xaml.g.h")
 
 #include "%.xaml.g.h"
@@ -1029,7 +1080,7 @@ namespace winrt::@::implementation
 
     static void write_generated_static_assert(writer& w)
     {
-        auto format = R"(
+        static constexpr char format[] = R"(
 // WARNING: This file is automatically generated by a tool. Do not directly
 // add this file to your project, as any changes you make will be lost.
 // This file is a stub you can use as a starting point for your implementation.
@@ -1066,7 +1117,7 @@ static_assert(false, "This file is generated by a tool and will be overwritten.
         }
 
         {
-            auto format = R"(#include "%.g.h"
+            static constexpr char format[] = R"(#include "%.g.h"
 %%
 namespace winrt::@::implementation
 {
@@ -1092,7 +1143,7 @@ namespace winrt::@::implementation
 
         if (has_factory_members(w, type))
         {
-            auto format = R"(namespace winrt::@::factory_implementation
+            static constexpr char format[] = R"(namespace winrt::@::factory_implementation
 {
     struct % : %T<%, implementation::%>
     {
@@ -1121,7 +1172,7 @@ namespace winrt::@::implementation
                     continue;
                 }
 
-                auto format = R"(    %::%(%)
+                static constexpr char format[] = R"(    %::%(%)
     {
         throw hresult_not_implemented();
     }
@@ -1150,7 +1201,7 @@ namespace winrt::@::implementation
             }
             else if (factory.statics)
             {
-                auto format = R"(    % %::%(%)%
+                static constexpr char format[] = R"(    % %::%(%)%
     {
         throw hresult_not_implemented();
     }
@@ -1183,7 +1234,7 @@ namespace winrt::@::implementation
 
             for (auto&& method : info.type.MethodList())
             {
-                auto format = R"(    % %::%(%)%
+                static constexpr char format[] = R"(    % %::%(%)%
     {
         throw hresult_not_implemented();
     }
@@ -1210,7 +1261,7 @@ namespace winrt::@::implementation
         {
             auto filename = get_component_filename(type);
 
-            auto format = R"(#include "%.h"
+            static constexpr char format[] = R"(#include "%.h"
 )";
 
             w.write(format, filename);
@@ -1220,13 +1271,13 @@ namespace winrt::@::implementation
         {
             auto filename = get_generated_component_filename(type);
 
-            auto format = R"(#include "%.g.cpp"
+            static constexpr char format[] = R"(#include "%.g.cpp"
 )";
 
             w.write(format, filename);
         }
 
-        auto format = R"(%
+        static constexpr char format[] = R"(%
 namespace winrt::@::implementation
 {
 %}
@@ -1242,7 +1293,7 @@ namespace winrt::@::implementation
     {
         for (uint32_t slot = 6; slot < 1024; ++slot)
         {
-            auto format = R"(    extern "C" void __stdcall winrt_ff_thunk%();
+            static constexpr char format[] = R"(    extern "C" void __stdcall winrt_ff_thunk%();
 )";
 
             w.write(format, slot);
@@ -1253,7 +1304,7 @@ namespace winrt::@::implementation
     {
         for (uint32_t slot = 6; slot < 1024; ++slot)
         {
-            auto format = R"(
+            static constexpr char format[] = R"(
 #if WINRT_FAST_ABI_SIZE > %
             winrt_ff_thunk%,
 #endif
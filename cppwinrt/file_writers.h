@@ -5,8 +5,9 @@ namespace cppwinrt
     static void write_base_h()
     {
         writer w;
+        profile_scope scope{ "file", "winrt/base.h", &w };
         write_preamble(w);
-        w.write(strings::base_version_odr, CPPWINRT_VERSION_STRING);
+        w.write(std::string_view{ strings::base_version_odr }, CPPWINRT_VERSION_STRING);
         {
             auto wrap_file_guard = wrap_open_file_guard(w, "BASE");
 
@@ -55,7 +56,7 @@ namespace cppwinrt
 
             auto const fast_abi_size = get_fastabi_size(w, classes);
 
-            w.write(strings::base_fast_forward,
+            w.write(std::string_view{ strings::base_fast_forward },
                 fast_abi_size,
                 fast_abi_size,
                 bind<write_component_fast_abi_thunk>(),
@@ -65,46 +66,47 @@ namespace cppwinrt
         w.flush_to_file(settings.output_folder + "winrt/fast_forward.h");
     }
 
-    static void write_namespace_0_h(std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_0_h(std::string_view const& ns, cache::namespace_members const& members)
     {
         writer w;
+        profile_scope scope{ "file", profile_name(w, "winrt/impl/%.0.h", ns), &w, ns };
         w.type_namespace = ns;
 
         {
             auto wrap_type = wrap_type_namespace(w, ns);
-            w.write_each<write_enum>(members.enums);
-            w.write_each<write_forward>(members.interfaces);
-            w.write_each<write_forward>(members.classes);
-            w.write_each<write_forward>(members.structs);
-            w.write_each<write_forward>(members.delegates);
-            w.write_each<write_forward>(members.contracts);
+            profile_each<write_enum>(w, "write_enum", members.enums);
+            profile_each<write_forward>(w, "write_forward", members.interfaces);
+            profile_each<write_forward>(w, "write_forward", members.classes);
+            profile_each<write_forward>(w, "write_forward", members.structs);
+            profile_each<write_forward>(w, "write_forward", members.delegates);
+            profile_each<write_forward>(w, "write_forward", members.contracts);
         }
         {
             auto wrap_impl = wrap_impl_namespace(w);
-            w.write_each<write_category>(members.interfaces, "interface_category");
-            w.write_each<write_category>(members.classes, "class_category");
-            w.write_each<write_category>(members.enums, "enum_category");
-            w.write_each<write_struct_category>(members.structs);
-            w.write_each<write_category>(members.delegates, "delegate_category");
+            profile_each<write_category>(w, "write_category", members.interfaces, "interface_category");
+            profile_each<write_category>(w, "write_category", members.classes, "class_category");
+            profile_each<write_category>(w, "write_category", members.enums, "enum_category");
+            profile_each<write_struct_category>(w, "write_struct_category", members.structs);
+            profile_each<write_category>(w, "write_category", members.delegates, "delegate_category");
 
             // Class names are always required for activation.
             // Class, enum, and struct names are required for producing GUIDs for generic types.
             // Interface and delegates names are required for Xaml compatibility.
             // Contract names are used by IsApiContractPresent.
-            w.write_each<write_name>(members.classes);
-            w.write_each<write_name>(members.enums);
-            w.write_each<write_name>(members.structs);
-            w.write_each<write_name>(members.interfaces);
-            w.write_each<write_name>(members.delegates);
-            w.write_each<write_name>(members.contracts);
-
-            w.write_each<write_guid>(members.interfaces);
-            w.write_each<write_guid>(members.delegates);
-            w.write_each<write_default_interface>(members.classes);
-            w.write_each<write_interface_abi>(members.interfaces);
-            w.write_each<write_delegate_abi>(members.delegates);
-            w.write_each<write_consume>(members.interfaces);
-            w.write_each<write_struct_abi>(members.structs);
+            profile_each<write_name>(w, "write_name", members.classes);
+            profile_each<write_name>(w, "write_name", members.enums);
+            profile_each<write_name>(w, "write_name", members.structs);
+            profile_each<write_name>(w, "write_name", members.interfaces);
+            profile_each<write_name>(w, "write_name", members.delegates);
+            profile_each<write_name>(w, "write_name", members.contracts);
+
+            profile_each<write_guid>(w, "write_guid", members.interfaces);
+            profile_each<write_guid>(w, "write_guid", members.delegates);
+            profile_each<write_default_interface>(w, "write_default_interface", members.classes);
+            profile_each<write_interface_abi>(w, "write_interface_abi", members.interfaces);
+            profile_each<write_delegate_abi>(w, "write_delegate_abi", members.delegates);
+            profile_each<write_consume>(w, "write_consume", members.interfaces);
+            profile_each<write_struct_abi>(w, "write_struct_abi", members.structs);
         }
 
         write_close_file_guard(w);
@@ -119,18 +121,23 @@ namespace cppwinrt
         }
 
         w.save_header('0');
+        return w.depends_namespaces();
     }
 
-    static void write_namespace_1_h(std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_1_h(std::string_view const& ns, cache::namespace_members const& members, include_graph& graph)
     {
         writer w;
+        profile_scope scope{ "file", profile_name(w, "winrt/impl/%.1.h", ns), &w, ns };
         w.type_namespace = ns;
 
         {
             auto wrap_type = wrap_type_namespace(w, ns);
-            w.write_each<write_interface>(members.interfaces);
+            profile_each<write_interface>(w, "write_interface", members.interfaces);
+        }
+        {
+            profile_scope special{ "writer", "write_namespace_special_1", &w };
+            write_namespace_special_1(w, ns);
         }
-        write_namespace_special_1(w, ns);
 
         write_close_file_guard(w);
         w.swap();
@@ -143,21 +150,29 @@ namespace cppwinrt
         }
 
         w.write_depends(w.type_namespace, '0');
+        graph.add(w.write_temp("impl/%.1", ns), w.includes);
         w.save_header('1');
+        return w.depends_namespaces();
     }
 
-    static void write_namespace_2_h(std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_2_h(std::string_view const& ns, cache::namespace_members const& members, include_graph& graph)
     {
         writer w;
+        profile_scope scope{ "file", profile_name(w, "winrt/impl/%.2.h", ns), &w, ns };
         w.type_namespace = ns;
 
         bool promote;
         {
             auto wrap_type = wrap_type_namespace(w, ns);
-            w.write_each<write_delegate>(members.delegates);
-            promote = write_structs(w, members.structs);
-            w.write_each<write_class>(members.classes);
-            w.write_each<write_interface_override>(members.classes);
+            profile_each<write_delegate>(w, "write_delegate", members.delegates);
+
+            {
+                profile_scope structs{ "writer", "write_structs", &w };
+                promote = write_structs(w, members.structs);
+            }
+
+            profile_each<write_class>(w, "write_class", members.classes);
+            profile_each<write_interface_override>(w, "write_interface_override", members.classes);
         }
 
         write_close_file_guard(w);
@@ -173,47 +188,53 @@ namespace cppwinrt
         }
 
         w.write_depends(w.type_namespace, '1');
+        graph.add(w.write_temp("impl/%.2", ns), w.includes);
         w.save_header('2');
+        return w.depends_namespaces();
     }
 
-    static void write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members)
+    static auto write_namespace_h(cache const& c, std::string_view const& ns, cache::namespace_members const& members, include_graph& graph)
     {
         writer w;
+        profile_scope scope{ "file", profile_name(w, "winrt/%.h", ns), &w, ns };
         w.type_namespace = ns;
 
         {
             auto wrap_impl = wrap_impl_namespace(w);
-            w.write_each<write_consume_definitions>(members.interfaces);
+            profile_each<write_consume_definitions>(w, "write_consume_definitions", members.interfaces);
             w.param_names = true;
-            w.write_each<write_delegate_implementation>(members.delegates);
-            w.write_each<write_produce>(members.interfaces, c);
-            w.write_each<write_dispatch_overridable>(members.classes);
+            profile_each<write_delegate_implementation>(w, "write_delegate_implementation", members.delegates);
+            profile_each<write_produce>(w, "write_produce", members.interfaces, c);
+            profile_each<write_dispatch_overridable>(w, "write_dispatch_overridable", members.classes);
         }
         {
             auto wrap_type = wrap_type_namespace(w, ns);
-            w.write_each<write_enum_operators>(members.enums);
-            w.write_each<write_class_definitions>(members.classes);
-            w.write_each<write_fast_class_base_definitions>(members.classes);
-            w.write_each<write_delegate_definition>(members.delegates);
-            w.write_each<write_interface_override_methods>(members.classes);
-            w.write_each<write_class_override>(members.classes);
+            profile_each<write_enum_operators>(w, "write_enum_operators", members.enums);
+            profile_each<write_class_definitions>(w, "write_class_definitions", members.classes);
+            profile_each<write_fast_class_base_definitions>(w, "write_fast_class_base_definitions", members.classes);
+            profile_each<write_delegate_definition>(w, "write_delegate_definition", members.delegates);
+            profile_each<write_interface_override_methods>(w, "write_interface_override_methods", members.classes);
+            profile_each<write_class_override>(w, "write_class_override", members.classes);
         }
         {
             auto wrap_std = wrap_std_namespace(w);
 
             {
                 auto wrap_lean = wrap_lean_and_mean(w);
-                w.write_each<write_std_hash>(members.interfaces);
-                w.write_each<write_std_hash>(members.classes);
+                profile_each<write_std_hash>(w, "write_std_hash", members.interfaces);
+                profile_each<write_std_hash>(w, "write_std_hash", members.classes);
             }
             {
                 auto wrap_format = wrap_ifdef(w, "__cpp_lib_format");
-                w.write_each<write_std_formatter>(members.interfaces);
-                w.write_each<write_std_formatter>(members.classes);   
+                profile_each<write_std_formatter>(w, "write_std_formatter", members.interfaces);
+                profile_each<write_std_formatter>(w, "write_std_formatter", members.classes);   
             }
         }
 
-        write_namespace_special(w, ns);
+        {
+            profile_scope special{ "writer", "write_namespace_special", &w };
+            write_namespace_special(w, ns);
+        }
 
         write_close_file_guard(w);
         w.swap();
@@ -222,13 +243,24 @@ namespace cppwinrt
         write_version_assert(w);
         write_parent_depends(w, c, ns);
 
+        // Any include that another one is known to pull in can be left out.
+        std::vector<std::string> includes;
+
         for (auto&& depends : w.depends)
         {
-            w.write_depends(depends.first, '2');
+            includes.push_back(w.write_temp("impl/%.2", depends.first));
+        }
+
+        includes.push_back(w.write_temp("impl/%.2", w.type_namespace));
+
+        for (auto&& include : graph.minimize(includes))
+        {
+            w.write_root_include(include);
         }
 
-        w.write_depends(w.type_namespace, '2');
+        graph.add(std::string{ ns }, w.includes);
         w.save_header();
+        return w.depends_namespaces();
     }
 
     static void write_module_g_cpp(std::vector<TypeDef> const& classes)
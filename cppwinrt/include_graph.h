@@ -0,0 +1,181 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Holds the impl/%.2.h includes that are known from the metadata alone, so that namespace headers can leave out
+    // includes that are already reached through another include, and records the #includes of each generated header
+    // so that the namespace dependency graph can be saved for build tools. Headers are identified by the name passed
+    // to writer::write_root_include, such as "impl/Windows.Foundation.2".
+    struct include_graph
+    {
+        // Adds the promoted includes of a namespace (see get_promoted_depends). These are all added before any header
+        // is written, so the includes that minimize drops don't depend on which headers a run writes (for example
+        // with -incremental) or on the order in which they are written.
+        void add_promoted(std::string_view const& ns, std::set<std::string_view> const& depends)
+        {
+            auto& includes = m_promoted[impl_name(ns)];
+
+            for (auto&& depend : depends)
+            {
+                includes.push_back(impl_name(depend));
+            }
+        }
+
+        void add(std::string header, std::vector<std::string> includes)
+        {
+            std::lock_guard lock(m_lock);
+            m_headers[std::move(header)] = std::move(includes);
+        }
+
+        // Returns the includes, in their original order, less any that are reachable through another include that is
+        // kept.
+        std::vector<std::string> minimize(std::vector<std::string> const& includes) const
+        {
+            std::vector<std::set<std::string_view>> reachable;
+
+            for (auto&& include : includes)
+            {
+                reachable.push_back(get_reachable(include));
+            }
+
+            std::vector<bool> dropped(includes.size());
+
+            for (size_t index = 0; index < includes.size(); ++index)
+            {
+                for (size_t other = 0; other < includes.size(); ++other)
+                {
+                    if (!dropped[other] && includes[other] != includes[index] && reachable[other].count(includes[index]))
+                    {
+                        dropped[index] = true;
+                        break;
+                    }
+                }
+            }
+
+            std::vector<std::string> result;
+
+            for (size_t index = 0; index < includes.size(); ++index)
+            {
+                if (!dropped[index])
+                {
+                    result.push_back(includes[index]);
+                }
+            }
+
+            return result;
+        }
+
+        void save(std::string const& filename) const
+        {
+            std::lock_guard lock(m_lock);
+            std::map<std::string_view, std::set<std::string_view>> namespaces;
+
+            for (auto&& [header, includes] : m_headers)
+            {
+                auto& depends = namespaces[get_namespace(header)];
+
+                for (auto&& include : includes)
+                {
+                    auto ns = get_namespace(include);
+
+                    if (ns != get_namespace(header) && ns != "base")
+                    {
+                        depends.insert(ns);
+                    }
+                }
+            }
+
+            writer w;
+            w.write("{\n  \"namespaces\": {");
+            bool first = true;
+
+            for (auto&& [ns, depends] : namespaces)
+            {
+                w.write(first ? "\n    \"%\": [" : ",\n    \"%\": [", ns);
+                write_list(w, depends);
+                first = false;
+            }
+
+            w.write("\n  },\n  \"headers\": {");
+            first = true;
+
+            for (auto&& [header, includes] : m_headers)
+            {
+                w.write(first ? "\n    \"winrt/%.h\": [" : ",\n    \"winrt/%.h\": [", header);
+                write_list(w, includes, "winrt/%.h");
+                first = false;
+            }
+
+            w.write("\n  }\n}\n");
+            w.flush_to_file(filename);
+        }
+
+    private:
+
+        std::set<std::string_view> get_reachable(std::string_view const& from) const
+        {
+            std::set<std::string_view> visited;
+            std::vector<std::string_view> pending{ from };
+
+            while (!pending.empty())
+            {
+                auto header = pending.back();
+                pending.pop_back();
+                auto found = m_promoted.find(header);
+
+                if (found == m_promoted.end())
+                {
+                    continue;
+                }
+
+                for (auto&& include : found->second)
+                {
+                    if (visited.insert(include).second)
+                    {
+                        pending.push_back(include);
+                    }
+                }
+            }
+
+            return visited;
+        }
+
+        static std::string impl_name(std::string_view const& ns)
+        {
+            std::string result{ "impl/" };
+            result += ns;
+            result += ".2";
+            return result;
+        }
+
+        static std::string_view get_namespace(std::string_view header) noexcept
+        {
+            if (header.substr(0, 5) == "impl/")
+            {
+                header = header.substr(5, header.size() - 7);
+            }
+
+            return header;
+        }
+
+        template <typename List>
+        static void write_list(writer& w, List const& list, std::string_view const& format = "%")
+        {
+            bool first = true;
+
+            for (auto&& item : list)
+            {
+                w.write(first ? "\"" : ", \"");
+                w.write(format, item);
+                w.write('"');
+                first = false;
+            }
+
+            w.write(']');
+        }
+
+        mutable std::mutex m_lock;
+        std::map<std::string, std::vector<std::string>, std::less<>> m_headers;
+        std::map<std::string, std::vector<std::string>, std::less<>> m_promoted;
+    };
+}
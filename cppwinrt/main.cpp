@@ -1,17 +1,25 @@
 #include "pch.h"
 #include <ctime>
+#include <cstdlib>
+#include <new>
 #include "strings.h"
 #include "settings.h"
 #include "type_writers.h"
+#include "profiler.h"
+#include "include_graph.h"
 #include "helpers.h"
 #include "code_writers.h"
 #include "component_writers.h"
 #include "file_writers.h"
 #include "type_writers.h"
+#include "manifest.h"
+#include "metadata_files.h"
+#include "server.h"
 
 namespace cppwinrt
 {
     settings_type settings;
+    profiler profile;
 
     struct usage_exception {};
 
@@ -30,6 +38,13 @@ namespace cppwinrt
         { "exclude", 0, option::no_max, "<prefix>", "One or more prefixes to exclude from input" },
         { "base", 0, 0, {}, "Generate base.h unconditionally" },
         { "optimize", 0, 0, {}, "Generate component projection with unified construction support" },
+        { "jobs", 0, 1, "<count>", "Maximum number of worker threads (defaults to number of processors)" },
+        { "incremental", 0, 0, {}, "Skip namespaces whose metadata and options are unchanged since the last run" },
+        { "profile", 0, 1, "<path>", "Write generator timing, output size and allocation data as a Chrome trace" },
+        { "reference_index", 0, 1, "<path>", "Folder for reusing the namespace indexes used to select which references to load" },
+        { "deps", 0, 1, "[<path>]", "Write the namespace and header include graph as JSON (defaults to deps.json)" },
+        { "server", 0, 1, "<name>", "Keep metadata loaded and serve -connect requests on a local socket or pipe" },
+        { "connect", 0, 1, "<name>", "Run on a -server if one is listening (runs locally otherwise)" },
         { "help", 0, option::no_max, {}, "Show detailed help with examples" },
         { "?", 0, option::no_max, {}, {} },
         { "library", 0, 1, "<prefix>", "Specify library prefix (defaults to winrt)" },
@@ -94,12 +109,60 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
         settings.license = args.exists("license");
         settings.brackets = args.exists("brackets");
+        settings.incremental = args.exists("incremental");
+
+        if (args.exists("profile"))
+        {
+            auto profile_path = args.value("profile");
+
+            if (profile_path.empty())
+            {
+                throw_invalid("Option '-profile' requires a file name");
+            }
+
+            profile.enable(absolute(profile_path).string());
+        }
+
+        if (args.exists("reference_index"))
+        {
+            path reference_index = args.value("reference_index");
+
+            if (reference_index.empty())
+            {
+                throw_invalid("Option '-reference_index' requires a folder");
+            }
+
+            create_directories(reference_index);
+            settings.reference_index = canonical(reference_index).string();
+            settings.reference_index += std::filesystem::path::preferred_separator;
+        }
+
+        if (args.exists("jobs"))
+        {
+            auto jobs = args.value("jobs");
+            char* end{};
+            auto value = std::strtoul(jobs.c_str(), &end, 10);
+
+            if (jobs.empty() || *end || value == 0 || value > 1024)
+            {
+                throw_invalid("Option '-jobs' requires a count between 1 and 1024");
+            }
+
+            settings.jobs = static_cast<uint32_t>(value);
+        }
 
         path output_folder = args.value("output", ".");
         create_directories(output_folder / "winrt/impl");
         settings.output_folder = canonical(output_folder).string();
         settings.output_folder += std::filesystem::path::preferred_separator;
 
+        if (args.exists("deps"))
+        {
+            path deps = args.value("deps", settings.output_folder + "deps.json");
+            create_directories(absolute(deps).parent_path());
+            settings.deps = absolute(deps).string();
+        }
+
         for (auto && include : args.values("include"))
         {
             settings.include.insert(include);
@@ -189,14 +252,6 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         }
     }
 
-    static auto get_files_to_cache()
-    {
-        std::vector<std::string> files;
-        files.insert(files.end(), settings.input.begin(), settings.input.end());
-        files.insert(files.end(), settings.reference.begin(), settings.reference.end());
-        return files;
-    }
-
     static void build_filters(cache const& c)
     {
         if (settings.reference.empty())
@@ -262,6 +317,23 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         }
     }
 
+    static bool has_namespace_headers(std::string_view const& ns)
+    {
+        auto const folder = settings.output_folder + "winrt/";
+
+        for (auto&& suffix : { ".h", ".0.h", ".1.h", ".2.h" })
+        {
+            auto filename = folder + (suffix[1] == 'h' ? "" : "impl/") + std::string{ ns } + suffix;
+
+            if (!exists(filename))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     static void remove_foundation_types(cache& c)
     {
         c.remove_type("Windows.Foundation", "DateTime");
@@ -281,10 +353,153 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
         c.remove_type("Windows.Foundation.Numerics", "Vector4");
     }
 
-    static int run(int const argc, char** argv)
+    // Set while running as a -server, in which case loaded metadata is kept for later requests.
+    static bool serving{};
+
+    // Returns a cache of the metadata files, less the foundation types that the base library projects itself. A
+    // -server keeps the caches of recent requests so that repeated builds against the same metadata don't reload it.
+    // Entries are keyed by the files along with their size and last write time, so a rebuilt winmd is picked up by
+    // the next request.
+    static std::shared_ptr<cache> load_cache(std::vector<std::string> const& files)
+    {
+        auto load = [&]
+        {
+            auto result = std::make_shared<cache>(files, [](TypeDef const& type) { return type.Flags().WindowsRuntime(); });
+            remove_foundation_types(*result);
+            return result;
+        };
+
+        if (!serving)
+        {
+            return load();
+        }
+
+        struct resident
+        {
+            std::string key;
+            std::shared_ptr<cache> value;
+            uint64_t used{};
+        };
+
+        static std::vector<resident> residents;
+        static uint64_t requests{};
+        constexpr size_t max_residents{ 4 };
+
+        std::string key;
+
+        for (auto&& file : files)
+        {
+            key += file;
+            key += '|';
+            key += std::to_string(std::filesystem::file_size(file));
+            key += '|';
+            key += std::to_string(std::filesystem::last_write_time(file).time_since_epoch().count());
+            key += '\n';
+        }
+
+        ++requests;
+
+        for (auto&& item : residents)
+        {
+            if (item.key == key)
+            {
+                item.used = requests;
+                return item.value;
+            }
+        }
+
+        if (residents.size() == max_residents)
+        {
+            residents.erase(std::min_element(residents.begin(), residents.end(), [](auto&& left, auto&& right)
+            {
+                return left.used < right.used;
+            }));
+        }
+
+        residents.push_back({ std::move(key), load(), requests });
+        return residents.back().value;
+    }
+
+    static int run(int const argc, char** argv, writer& w, bool const console);
+
+    // Serves -connect requests one at a time, since a request replaces the global settings.
+    static void serve(std::string const& name, writer& w)
+    {
+        local_listener listener{ name };
+        serving = true;
+        w.write("cppwinrt : serving requests on %\n", name);
+        w.flush_to_console();
+
+        while (true)
+        {
+            auto connection = listener.accept();
+            std::string message;
+
+            if (!connection || !connection.receive(message))
+            {
+                continue;
+            }
+
+            auto request = server_request::decode(message);
+            std::vector<char*> argv;
+
+            for (auto&& arg : request.args)
+            {
+                argv.push_back(arg.data());
+            }
+
+            argv.push_back(nullptr);
+            server_response response;
+            writer output;
+
+            try
+            {
+                std::filesystem::current_path(request.directory);
+                settings = settings_type{};
+                profile.reset();
+                response.result = run(static_cast<int>(request.args.size()), argv.data(), output, false);
+            }
+            catch (std::exception const& e)
+            {
+                output.write("cppwinrt : error %\n", e.what());
+                response.result = 1;
+            }
+
+            response.output = output.flush_to_string();
+            connection.send(response.encode());
+        }
+    }
+
+    // Returns false if no server is listening, in which case the request runs locally.
+    static bool forward(std::string const& name, int const argc, char** argv, writer& w, int& result)
+    {
+        auto connection = local_connection::connect(name);
+
+        if (!connection)
+        {
+            return false;
+        }
+
+        server_request request;
+        request.directory = std::filesystem::current_path().string();
+        request.args.assign(argv, argv + argc);
+
+        std::string message;
+        server_response response;
+
+        if (!connection.send(request.encode()) || !connection.receive(message) || !server_response::decode(message, response))
+        {
+            return false;
+        }
+
+        w.write(response.output);
+        result = response.result;
+        return true;
+    }
+
+    static int run(int const argc, char** argv, writer& w, bool const console)
     {
         int result{};
-        writer w;
 
         try
         {
@@ -297,12 +512,28 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
                 throw usage_exception{};
             }
 
+            // A -server ignores these so that clients can pass their command line through unchanged.
+            if (console && args.exists("server"))
+            {
+                serve(args.value("server"), w);
+                return result;
+            }
+
+            if (console && args.exists("connect") && forward(args.value("connect"), argc, argv, w, result))
+            {
+                return result;
+            }
+
             process_args(args);
-            cache c{ get_files_to_cache(), [](TypeDef const& type) { return type.Flags().WindowsRuntime(); } };
-            remove_foundation_types(c);
+            std::optional<profile_scope> load{ std::in_place, "phase", "load metadata" };
+            metadata_index_cache indexes{ settings.reference_index };
+            auto const files = get_metadata_files(indexes);
+            auto const resident = load_cache(files);
+            cache& c = *resident;
             build_filters(c);
             settings.base = settings.base || (!settings.component && settings.projection_filter.empty());
             build_fastabi_cache(c);
+            load.reset();
 
             if (settings.verbose)
             {
@@ -331,6 +562,16 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
                     w.write(" ref:   %\n", file);
                 }
 
+                if (files.size() < settings.input.size() + settings.reference.size())
+                {
+                    w.write(" lazy:  % reference files not loaded\n", settings.input.size() + settings.reference.size() - files.size());
+                }
+
+                if (!settings.reference_index.empty())
+                {
+                    w.write(" idx:   % (% indexes reused)\n", settings.reference_index, indexes.hits());
+                }
+
                 w.write(" out:   %\n", settings.output_folder);
 
                 if (!settings.component_folder.empty())
@@ -339,15 +580,57 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
                 }
             }
 
-            w.flush_to_console();
+            // The manifest of the previous run is removed as soon as it has been read so that an interrupted run
+            // can never leave behind a manifest that vouches for headers it did not finish writing.
+            auto const manifest_path = settings.output_folder + "winrt/impl/cppwinrt.manifest";
+            manifest previous;
+            manifest current;
+            fingerprint_builder fingerprints{ c };
+            size_t unchanged{};
+
+            if (settings.incremental)
+            {
+                previous.load(manifest_path);
+            }
+
+            std::error_code ignored;
+            std::filesystem::remove(manifest_path, ignored);
+
+            std::optional<profile_scope> generate{ std::in_place, "phase", "generate" };
+
+            // Component tasks refer to this list, so it must outlive the task group.
+            std::vector<TypeDef> classes;
+            include_graph graph;
             task_group group;
             group.synchronous(args.exists("synchronous"));
+            group.jobs(settings.jobs);
+
+            if (settings.verbose)
+            {
+                w.write(" jobs:  %\n", group.jobs());
+            }
+
+            if (console)
+            {
+                w.flush_to_console();
+            }
+
             writer ixx;
             write_preamble(ixx);
             ixx.write("module;\n");
             ixx.write(strings::base_includes);
             ixx.write("\nexport module winrt;\n#define WINRT_EXPORT export\n\n");
 
+            // The graph covers every projected namespace, including those that -incremental skips, so that the
+            // namespace headers are the same however many of them are written.
+            for (auto&&[ns, members] : c.namespaces())
+            {
+                if (has_projected_types(members) && settings.projection_filter.includes(members))
+                {
+                    graph.add_promoted(ns, get_promoted_depends(ns, members.structs));
+                }
+            }
+
             for (auto&&[ns, members] : c.namespaces())
             {
                 if (!has_projected_types(members) || !settings.projection_filter.includes(members))
@@ -357,25 +640,49 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
                 ixx.write("#include \"winrt/%.h\"\n", ns);
 
-                group.add([&, &ns = ns, &members = members]
+                if (settings.incremental)
+                {
+                    auto entry = previous.find(ns);
+
+                    if (entry && entry->fingerprint == fingerprints.get(ns, previous) && has_namespace_headers(ns))
+                    {
+                        current.add_depends(ns, { entry->depends.begin(), entry->depends.end() });
+                        ++unchanged;
+                        continue;
+                    }
+                }
+
+                // Each header is an independent task so that the largest namespaces are spread across
+                // workers rather than serializing the critical path on a single thread.
+                group.add(profile_name(w, "%.h", ns), [&, &ns = ns, &members = members]
+                {
+                    current.add_depends(ns, write_namespace_h(c, ns, members, graph));
+                });
+
+                group.add(profile_name(w, "impl/%.2.h", ns), [&, &ns = ns, &members = members]
+                {
+                    current.add_depends(ns, write_namespace_2_h(ns, members, graph));
+                });
+
+                group.add(profile_name(w, "impl/%.1.h", ns), [&, &ns = ns, &members = members]
                 {
-                    write_namespace_0_h(ns, members);
-                    write_namespace_1_h(ns, members);
-                    write_namespace_2_h(ns, members);
-                    write_namespace_h(c, ns, members);
+                    current.add_depends(ns, write_namespace_1_h(ns, members, graph));
+                });
+
+                group.add(profile_name(w, "impl/%.0.h", ns), [&, &ns = ns, &members = members]
+                {
+                    current.add_depends(ns, write_namespace_0_h(ns, members));
                 });
             }
 
             if (settings.base)
             {
-                write_base_h();
+                group.add("base.h", write_base_h);
                 ixx.flush_to_file(settings.output_folder + "winrt/winrt.ixx");
             }
 
             if (settings.component)
             {
-                std::vector<TypeDef> classes;
-
                 for (auto&&[ns, members] : c.namespaces())
                 {
                     for (auto&& type : members.classes)
@@ -389,23 +696,65 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
 
                 if (!classes.empty())
                 {
-                    write_fast_forward_h(classes);
-                    write_module_g_cpp(classes);
+                    group.add("fast_forward.h", [&] { write_fast_forward_h(classes); });
+                    group.add("module.g.cpp", [&] { write_module_g_cpp(classes); });
 
                     for (auto&& type : classes)
                     {
-                        write_component_g_h(type);
-                        write_component_g_cpp(type);
-                        write_component_h(type);
-                        write_component_cpp(type);
+                        auto name = profile_name(w, "%.%", type.TypeNamespace(), type.TypeName());
+
+                        group.add(name, [&, type, name]
+                        {
+                            profile_scope scope{ "component", name, nullptr, type.TypeNamespace() };
+                            write_component_g_h(type);
+                            write_component_g_cpp(type);
+                            write_component_h(type);
+                            write_component_cpp(type);
+                        });
                     }
                 }
             }
 
             group.get();
+            generate.reset();
+
+            if (!settings.deps.empty())
+            {
+                graph.save(settings.deps);
+            }
+
+            if (settings.incremental)
+            {
+                for (auto&& [ns, item] : current.entries())
+                {
+                    item.fingerprint = fingerprints.get(ns, current);
+                }
+
+                current.save(manifest_path);
+            }
+
+            profile.save();
 
             if (settings.verbose)
             {
+                auto timings = group.timings();
+                auto const count = (std::min)(timings.size(), size_t{ 10 });
+
+                std::partial_sort(timings.begin(), timings.begin() + count, timings.end(), [](auto&& left, auto&& right)
+                {
+                    return left.elapsed > right.elapsed;
+                });
+
+                for (size_t index = 0; index < count; ++index)
+                {
+                    w.write(" task:  %ms %\n", timings[index].elapsed, timings[index].name);
+                }
+
+                if (settings.incremental)
+                {
+                    w.write(" skip:  % unchanged namespaces\n", unchanged);
+                }
+
                 w.write(" time:  %ms\n", get_elapsed_time(start));
             }
         }
@@ -419,11 +768,45 @@ R"(  local               Local ^%WinDir^%\System32\WinMetadata folder
             result = 1;
         }
 
+        return result;
+    }
+
+    static int run(int const argc, char** argv)
+    {
+        writer w;
+        auto const result = run(argc, argv, w, true);
         w.flush_to_console(result == 0);
         return result;
     }
 }
 
+// The replacement allocation functions only count allocations (per thread, so that task timings and allocation
+// counts line up) while -profile is enabled. The array and nothrow forms forward to these by default.
+void* operator new(std::size_t size)
+{
+    if (cppwinrt::allocation_counting.load(std::memory_order_relaxed))
+    {
+        ++cppwinrt::allocation_count;
+    }
+
+    if (auto result = std::malloc(size ? size : 1))
+    {
+        return result;
+    }
+
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* value) noexcept
+{
+    std::free(value);
+}
+
+void operator delete(void* value, std::size_t) noexcept
+{
+    std::free(value);
+}
+
 int main(int const argc, char** argv)
 {
     return cppwinrt::run(argc, argv);
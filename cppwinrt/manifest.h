@@ -0,0 +1,295 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // 64-bit FNV-1a, used to fingerprint generator inputs for incremental builds.
+    struct fingerprint_hasher
+    {
+        void add(void const* data, size_t size) noexcept
+        {
+            auto bytes = static_cast<uint8_t const*>(data);
+
+            for (size_t index = 0; index < size; ++index)
+            {
+                m_value ^= bytes[index];
+                m_value *= 1099511628211ULL;
+            }
+        }
+
+        void add(std::string_view const& value) noexcept
+        {
+            add(value.data(), value.size());
+            add(uint64_t{ value.size() });
+        }
+
+        void add(uint64_t const value) noexcept
+        {
+            add(&value, sizeof(value));
+        }
+
+        void add(bool const value) noexcept
+        {
+            add(uint64_t{ value });
+        }
+
+        uint64_t value() const noexcept
+        {
+            return m_value;
+        }
+
+    private:
+
+        uint64_t m_value{ 14695981039346656037ULL };
+    };
+
+    inline uint64_t hash_file(std::string const& filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+
+        if (file.fail())
+        {
+            throw_invalid("Cannot read '", filename, "'");
+        }
+
+        fingerprint_hasher hasher;
+        std::vector<char> buffer(64 * 1024);
+
+        while (file)
+        {
+            file.read(buffer.data(), buffer.size());
+            hasher.add(buffer.data(), static_cast<size_t>(file.gcount()));
+        }
+
+        return hasher.value();
+    }
+
+    // The manifest records, for each projected namespace, a fingerprint of everything its headers were generated
+    // from along with the namespaces those headers referenced. The dependencies are recorded rather than computed
+    // up front because they are only known once the headers have been written, and they cannot change unless the
+    // namespace's own metadata changes first.
+    struct manifest
+    {
+        struct entry
+        {
+            uint64_t fingerprint{};
+            std::set<std::string> depends;
+        };
+
+        void load(std::string const& filename)
+        {
+            std::ifstream file(filename);
+            std::string line;
+
+            if (!getline(file, line) || line != header())
+            {
+                return;
+            }
+
+            while (getline(file, line))
+            {
+                std::istringstream stream(line);
+                std::string ns;
+                std::string fingerprint;
+
+                if (!(stream >> ns >> fingerprint))
+                {
+                    continue;
+                }
+
+                auto& item = m_entries[ns];
+                item.fingerprint = std::strtoull(fingerprint.c_str(), nullptr, 16);
+
+                for (std::string depends; stream >> depends;)
+                {
+                    item.depends.insert(depends);
+                }
+            }
+        }
+
+        void save(std::string const& filename) const
+        {
+            writer w;
+            w.write("%\n", header());
+
+            for (auto&& [ns, item] : m_entries)
+            {
+                w.write(ns);
+                w.write_printf(" %016llx", static_cast<unsigned long long>(item.fingerprint));
+
+                for (auto&& depends : item.depends)
+                {
+                    w.write(" %", depends);
+                }
+
+                w.write('\n');
+            }
+
+            w.flush_to_file(filename);
+        }
+
+        entry const* find(std::string_view const& ns) const
+        {
+            auto item = m_entries.find(std::string{ ns });
+            return item == m_entries.end() ? nullptr : &item->second;
+        }
+
+        void add_depends(std::string_view const& ns, std::vector<std::string_view> const& depends)
+        {
+            std::lock_guard lock(m_lock);
+            auto& item = m_entries[std::string{ ns }];
+
+            for (auto&& name : depends)
+            {
+                if (name != ns)
+                {
+                    item.depends.emplace(name);
+                }
+            }
+        }
+
+        auto& entries() noexcept
+        {
+            return m_entries;
+        }
+
+    private:
+
+        static std::string_view header() noexcept
+        {
+            return "cppwinrt-manifest 1";
+        }
+
+        std::map<std::string, entry> m_entries;
+        std::mutex m_lock;
+    };
+
+    // Computes namespace fingerprints from the generator settings, the namespace's own types and the types of every
+    // namespace in its recorded dependency closure. Types are fingerprinted by name together with a content hash of
+    // the winmd file that defines them.
+    struct fingerprint_builder
+    {
+        explicit fingerprint_builder(cache const& c) : m_cache(c)
+        {
+            fingerprint_hasher hasher;
+            hasher.add(std::string_view{ CPPWINRT_VERSION_STRING });
+
+            for (auto&& file : settings.input)
+            {
+                hasher.add(std::string_view{ "input" });
+                hasher.add(file);
+            }
+
+            for (auto&& file : settings.reference)
+            {
+                hasher.add(std::string_view{ "reference" });
+                hasher.add(file);
+            }
+
+            for (auto&& prefix : settings.include)
+            {
+                hasher.add(std::string_view{ "include" });
+                hasher.add(prefix);
+            }
+
+            for (auto&& prefix : settings.exclude)
+            {
+                hasher.add(std::string_view{ "exclude" });
+                hasher.add(prefix);
+            }
+
+            hasher.add(settings.license);
+            hasher.add(settings.license_template);
+            hasher.add(settings.brackets);
+            hasher.add(settings.fastabi);
+            hasher.add(settings.component);
+            hasher.add(settings.component_name);
+            hasher.add(settings.component_pch);
+            hasher.add(settings.component_prefix);
+            hasher.add(settings.component_opt);
+            hasher.add(settings.component_ignore_velocity);
+            m_settings = hasher.value();
+        }
+
+        uint64_t get(std::string_view const& ns, manifest const& graph)
+        {
+            std::set<std::string_view> closure;
+            add_closure(ns, graph, closure);
+
+            fingerprint_hasher hasher;
+            hasher.add(m_settings);
+            hasher.add(ns);
+
+            for (auto&& name : closure)
+            {
+                hasher.add(name);
+                hasher.add(get_content(name));
+            }
+
+            return hasher.value();
+        }
+
+    private:
+
+        void add_closure(std::string_view const& ns, manifest const& graph, std::set<std::string_view>& closure)
+        {
+            if (!closure.insert(ns).second)
+            {
+                return;
+            }
+
+            if (auto item = graph.find(ns))
+            {
+                for (auto&& depends : item->depends)
+                {
+                    add_closure(depends, graph, closure);
+                }
+            }
+        }
+
+        uint64_t get_content(std::string_view const& ns)
+        {
+            auto [content, inserted] = m_content.try_emplace(std::string{ ns });
+
+            if (!inserted)
+            {
+                return content->second;
+            }
+
+            fingerprint_hasher hasher;
+            auto members = m_cache.namespaces().find(ns);
+
+            if (members == m_cache.namespaces().end())
+            {
+                hasher.add(std::string_view{ "missing" });
+            }
+            else
+            {
+                for (auto&& [name, type] : members->second.types)
+                {
+                    hasher.add(name);
+                    hasher.add(get_file(type.get_database().path()));
+                }
+            }
+
+            content->second = hasher.value();
+            return content->second;
+        }
+
+        uint64_t get_file(std::string const& filename)
+        {
+            auto [file, inserted] = m_files.try_emplace(filename);
+
+            if (inserted)
+            {
+                file->second = hash_file(filename);
+            }
+
+            return file->second;
+        }
+
+        cache const& m_cache;
+        uint64_t m_settings{};
+        std::map<std::string, uint64_t> m_content;
+        std::map<std::string, uint64_t> m_files;
+    };
+}
@@ -0,0 +1,384 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // The namespaces a metadata file defines types in and the namespaces its TypeRefs (and the type names stored as
+    // strings in its factory attributes) point to. This is all that is needed to decide which reference files the
+    // cache has to load. A file is unresolved when one of those strings could not be read, in which case every
+    // reference is loaded.
+    struct metadata_index
+    {
+        std::string path;
+        std::set<std::string> defines;
+        std::set<std::string> references;
+        bool unresolved{};
+    };
+
+    // Stores the indexes of reference files under the -reference_index folder so that repeated runs against the
+    // same references (typically one per project in a build) don't need to map and scan every reference file again.
+    // Only the selection of references is cached: the files that are selected are still loaded and resolved by the
+    // cache as usual, and runs that load every reference (see get_metadata_files) don't use the indexes at all.
+    // Entries are keyed by a hash of the file's path alone, so an entry is replaced rather than added to when its
+    // file changes. The size and last write time are verified on load.
+    struct metadata_index_cache
+    {
+        explicit metadata_index_cache(std::string folder) : m_folder(std::move(folder))
+        {
+        }
+
+        // Input files typically change between runs, so they are read directly rather than through the cache.
+        static metadata_index read(std::string const& file)
+        {
+            return read_database(file);
+        }
+
+        metadata_index get(std::string const& file)
+        {
+            if (m_folder.empty())
+            {
+                return read_database(file);
+            }
+
+            auto const stamp = get_stamp(file);
+            auto const filename = get_filename(file);
+            metadata_index result;
+
+            if (load(filename, file, stamp, result))
+            {
+                ++m_hits;
+                return result;
+            }
+
+            result = read_database(file);
+            save(filename, stamp, result);
+            return result;
+        }
+
+        size_t hits() const noexcept
+        {
+            return m_hits;
+        }
+
+    private:
+
+        struct file_stamp
+        {
+            uint64_t size{};
+            int64_t time{};
+        };
+
+        static metadata_index read_database(std::string const& file)
+        {
+            metadata_index result;
+            result.path = file;
+            database db{ file };
+
+            for (auto&& type : db.TypeDef)
+            {
+                if (!type.TypeNamespace().empty())
+                {
+                    result.defines.emplace(type.TypeNamespace());
+                }
+            }
+
+            for (auto&& type : db.TypeRef)
+            {
+                if (!type.TypeNamespace().empty())
+                {
+                    result.references.emplace(type.TypeNamespace());
+                }
+            }
+
+            for (auto&& attribute : db.CustomAttribute)
+            {
+                add_attribute_reference(attribute, result);
+            }
+
+            return result;
+        }
+
+        // Activatable, Static and Composable attributes name their factory and static interfaces with a System.Type
+        // argument, which is stored as a string rather than as a TypeRef. Reading an attribute blob requires the
+        // definition of any enum its constructor takes (such as Platform), which can't be resolved without the cache,
+        // so an attribute whose constructor isn't limited to primitives and System.Type marks the file unresolved.
+        static void add_attribute_reference(CustomAttribute const& attribute, metadata_index& result)
+        {
+            auto const [ns, name] = attribute.TypeNamespaceAndName();
+
+            if (ns != "Windows.Foundation.Metadata" || (name != "ActivatableAttribute" && name != "StaticAttribute" && name != "ComposableAttribute"))
+            {
+                return;
+            }
+
+            auto const ctor = attribute.Type().type() == CustomAttributeType::MemberRef ?
+                attribute.Type().MemberRef().MethodSignature() :
+                attribute.Type().MethodDef().Signature();
+
+            auto const params = ctor.Params();
+
+            bool const readable = std::all_of(params.first, params.second, [](ParamSig const& param)
+            {
+                auto const& type = param.Type().Type();
+
+                if (std::holds_alternative<ElementType>(type))
+                {
+                    return true;
+                }
+
+                auto index = std::get_if<coded_index<TypeDefOrRef>>(&type);
+                return index && index->type() == TypeDefOrRef::TypeRef && index->TypeRef().TypeNamespace() == "System" && index->TypeRef().TypeName() == "Type";
+            });
+
+            if (!readable)
+            {
+                result.unresolved = true;
+                return;
+            }
+
+            auto const signature = attribute.Value();
+
+            for (auto&& arg : signature.FixedArgs())
+            {
+                if (auto type = std::get_if<ElemSig::SystemType>(&std::get<ElemSig>(arg.value).value))
+                {
+                    auto const pos = type->name.rfind('.');
+
+                    if (pos != std::string_view::npos)
+                    {
+                        result.references.emplace(type->name.substr(0, pos));
+                    }
+                }
+            }
+        }
+
+        static file_stamp get_stamp(std::string const& file)
+        {
+            return { std::filesystem::file_size(file), static_cast<int64_t>(std::filesystem::last_write_time(file).time_since_epoch().count()) };
+        }
+
+        std::string get_filename(std::string const& file) const
+        {
+            fingerprint_hasher hasher;
+            hasher.add(file);
+
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx.idx", static_cast<unsigned long long>(hasher.value()));
+            return m_folder + name;
+        }
+
+        static std::string_view header() noexcept
+        {
+            return "cppwinrt-metadata-index 2";
+        }
+
+        static bool load(std::string const& filename, std::string const& file, file_stamp const& stamp, metadata_index& result)
+        {
+            std::ifstream stream(filename);
+            std::string line;
+
+            if (!getline(stream, line) || line != header())
+            {
+                return false;
+            }
+
+            if (!getline(stream, line) || line != file)
+            {
+                return false;
+            }
+
+            uint64_t size{};
+            int64_t time{};
+
+            if (!(stream >> size >> time) || size != stamp.size || time != stamp.time)
+            {
+                return false;
+            }
+
+            result.path = file;
+            getline(stream, line);
+
+            while (getline(stream, line))
+            {
+                if (line == "E")
+                {
+                    return true;
+                }
+
+                if (line == "U")
+                {
+                    result.unresolved = true;
+                    continue;
+                }
+
+                if (line.size() < 2 || line[1] != ' ')
+                {
+                    return false;
+                }
+
+                if (line[0] == 'D')
+                {
+                    result.defines.insert(line.substr(2));
+                }
+                else if (line[0] == 'R')
+                {
+                    result.references.insert(line.substr(2));
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            // A missing end marker means the entry was truncated.
+            return false;
+        }
+
+        static void save(std::string const& filename, file_stamp const& stamp, metadata_index const& index)
+        {
+            writer w;
+            w.write("%\n%\n% %\n", header(), index.path, stamp.size, stamp.time);
+
+            for (auto&& ns : index.defines)
+            {
+                w.write("D %\n", ns);
+            }
+
+            for (auto&& ns : index.references)
+            {
+                w.write("R %\n", ns);
+            }
+
+            if (index.unresolved)
+            {
+                w.write("U\n");
+            }
+
+            w.write("E\n");
+
+            // The cache is an optimization, so a folder that can't be written to (or a concurrent writer winning the
+            // race to replace the entry) must not fail the run.
+            try
+            {
+                w.flush_to_file(filename);
+            }
+            catch (std::exception const&)
+            {
+            }
+        }
+
+        std::string m_folder;
+        size_t m_hits{};
+    };
+
+    // Returns the metadata files the cache needs to load. Input files are always loaded. A reference file is loaded
+    // only once a type reference from a loaded file resolves into a namespace it defines, or into a child of one.
+    // Namespaces rather than individual types are followed since that is all the index records. If a loaded file
+    // names a type that its index could not resolve, every reference is loaded.
+    inline std::vector<std::string> get_metadata_files(metadata_index_cache& indexes)
+    {
+        std::vector<std::string> files{ settings.input.begin(), settings.input.end() };
+
+        // An explicit -include or -fastabi may pull in types that no input refers to, so those load everything.
+        if (settings.reference.empty() || !settings.include.empty() || settings.fastabi)
+        {
+            files.insert(files.end(), settings.reference.begin(), settings.reference.end());
+            return files;
+        }
+
+        std::vector<metadata_index> references;
+        std::map<std::string_view, std::vector<size_t>> definitions;
+
+        for (auto&& file : settings.reference)
+        {
+            if (!settings.input.count(file))
+            {
+                references.push_back(indexes.get(file));
+            }
+        }
+
+        for (size_t index = 0; index < references.size(); ++index)
+        {
+            for (auto&& ns : references[index].defines)
+            {
+                definitions[ns].push_back(index);
+            }
+        }
+
+        std::vector<metadata_index> inputs;
+
+        for (auto&& file : settings.input)
+        {
+            inputs.push_back(metadata_index_cache::read(file));
+        }
+
+        std::vector<bool> loaded(references.size());
+        std::set<std::string_view> visited;
+        std::vector<std::string_view> pending;
+        bool unresolved{};
+
+        // A namespace is reached together with its parents. The header for a namespace includes the header of its
+        // nearest parent namespace with projected types, and that parent may be defined only in another reference.
+        auto reach = [&](std::string_view ns)
+        {
+            while (!ns.empty() && visited.insert(ns).second)
+            {
+                pending.push_back(ns);
+                auto const pos = ns.rfind('.');
+                ns = pos == std::string_view::npos ? std::string_view{} : ns.substr(0, pos);
+            }
+        };
+
+        auto add_references = [&](metadata_index const& index)
+        {
+            unresolved = unresolved || index.unresolved;
+
+            for (auto&& ns : index.defines)
+            {
+                reach(ns);
+            }
+
+            for (auto&& ns : index.references)
+            {
+                reach(ns);
+            }
+        };
+
+        for (auto&& index : inputs)
+        {
+            add_references(index);
+        }
+
+        while (!pending.empty() && !unresolved)
+        {
+            auto ns = pending.back();
+            pending.pop_back();
+            auto owners = definitions.find(ns);
+
+            if (owners == definitions.end())
+            {
+                continue;
+            }
+
+            for (auto index : owners->second)
+            {
+                if (!loaded[index])
+                {
+                    loaded[index] = true;
+                    add_references(references[index]);
+                }
+            }
+        }
+
+        // The cache is given the selected files in their original order so that duplicate definitions resolve
+        // exactly as they would if every reference were loaded.
+        for (size_t index = 0; index < references.size(); ++index)
+        {
+            if (loaded[index] || unresolved)
+            {
+                files.push_back(references[index].path);
+            }
+        }
+
+        return files;
+    }
+}
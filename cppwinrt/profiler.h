@@ -0,0 +1,244 @@
+#pragma once
+
+namespace cppwinrt
+{
+    // Counts heap allocations made by the current thread. Incremented by the replacement operator new in main.cpp,
+    // but only while allocation_counting is set (by -profile) so that ordinary runs only pay for a relaxed load.
+    inline thread_local uint64_t allocation_count{};
+    inline std::atomic<bool> allocation_counting{};
+
+    // Collects timing, output size and allocation data for -profile and saves it in the Chrome trace event format
+    // (load the file in chrome://tracing or https://ui.perfetto.dev).
+    struct profiler
+    {
+        struct event
+        {
+            std::string name;
+            std::string_view category;
+            std::string ns;
+            uint32_t thread{};
+            int64_t start{};
+            int64_t duration{};
+            uint64_t bytes{};
+            uint64_t allocations{};
+        };
+
+        void enable(std::string filename)
+        {
+            m_filename = std::move(filename);
+            m_start = std::chrono::steady_clock::now();
+            m_enabled = true;
+            allocation_counting.store(true, std::memory_order_relaxed);
+        }
+
+        void reset()
+        {
+            std::lock_guard lock(m_lock);
+            m_enabled = false;
+            allocation_counting.store(false, std::memory_order_relaxed);
+            m_filename.clear();
+            m_events.clear();
+        }
+
+        bool enabled() const noexcept
+        {
+            return m_enabled;
+        }
+
+        int64_t now() const noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count();
+        }
+
+        uint32_t thread_index()
+        {
+            static thread_local uint32_t index = ++m_threads;
+            return index;
+        }
+
+        void add(event&& value)
+        {
+            std::lock_guard lock(m_lock);
+            m_events.push_back(std::move(value));
+        }
+
+        void save()
+        {
+            if (!m_enabled)
+            {
+                return;
+            }
+
+            std::lock_guard lock(m_lock);
+
+            // Namespace totals are reported as one span per namespace, each on its own row of a separate process,
+            // since the files of a namespace are generated concurrently on different threads.
+            struct total
+            {
+                int64_t start{ (std::numeric_limits<int64_t>::max)() };
+                int64_t end{};
+                uint64_t bytes{};
+                uint64_t allocations{};
+                uint32_t files{};
+            };
+
+            std::map<std::string_view, total> namespaces;
+
+            for (auto&& item : m_events)
+            {
+                if (item.category != "file" || item.ns.empty())
+                {
+                    continue;
+                }
+
+                auto& value = namespaces[item.ns];
+                value.start = (std::min)(value.start, item.start);
+                value.end = (std::max)(value.end, item.start + item.duration);
+                value.bytes += item.bytes;
+                value.allocations += item.allocations;
+                ++value.files;
+            }
+
+            writer w;
+            w.write(R"({"displayTimeUnit":"ms","traceEvents":[
+{"name":"process_name","ph":"M","pid":1,"args":{"name":"cppwinrt"}},
+{"name":"process_name","ph":"M","pid":2,"args":{"name":"namespaces"}})");
+
+            for (auto&& item : m_events)
+            {
+                w.write(",\n{\"name\":\"");
+                write_escaped(w, item.name);
+                w.write("\",\"cat\":\"%\",\"ph\":\"X\",\"pid\":1,\"tid\":%,\"ts\":%,\"dur\":%,\"args\":{",
+                    item.category,
+                    item.thread,
+                    item.start,
+                    item.duration);
+
+                if (!item.ns.empty())
+                {
+                    w.write("\"namespace\":\"");
+                    write_escaped(w, item.ns);
+                    w.write("\",");
+                }
+
+                w.write("\"bytes\":%,\"allocations\":%}}", item.bytes, item.allocations);
+            }
+
+            uint32_t row{};
+
+            for (auto&& [ns, value] : namespaces)
+            {
+                w.write(",\n{\"name\":\"");
+                write_escaped(w, ns);
+                w.write("\",\"cat\":\"namespace\",\"ph\":\"X\",\"pid\":2,\"tid\":%,\"ts\":%,\"dur\":%,\"args\":{\"files\":%,\"bytes\":%,\"allocations\":%}}",
+                    ++row,
+                    value.start,
+                    value.end - value.start,
+                    value.files,
+                    value.bytes,
+                    value.allocations);
+            }
+
+            w.write("\n]}\n");
+            w.flush_to_file(m_filename);
+        }
+
+    private:
+
+        static void write_escaped(writer& w, std::string_view const& value)
+        {
+            for (auto c : value)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    w.write('\\');
+                }
+
+                w.write(c);
+            }
+        }
+
+        bool m_enabled{};
+        std::string m_filename;
+        std::chrono::steady_clock::time_point m_start;
+        std::atomic<uint32_t> m_threads{};
+        std::mutex m_lock;
+        std::vector<event> m_events;
+    };
+
+    extern profiler profile;
+
+    // Formats the name of a profile span or task timing. Names are only reported under -profile or -verbose, so
+    // other runs get an empty name (which records nothing) rather than formatting one for every file and task.
+    template <typename... Args>
+    std::string profile_name(writer& w, std::string_view const& format, Args const&... args)
+    {
+        if (!profile.enabled() && !settings.verbose)
+        {
+            return {};
+        }
+
+        return w.write_temp(format, args...);
+    }
+
+    // Records a span covering its lifetime, along with the bytes the writer (if any) emitted and the allocations the
+    // current thread made in the meantime.
+    struct profile_scope
+    {
+        profile_scope(profile_scope const&) = delete;
+        profile_scope& operator=(profile_scope const&) = delete;
+
+        profile_scope(std::string_view const& category, std::string_view const& name, writer const* w = nullptr, std::string_view const& ns = {})
+        {
+            if (!profile.enabled())
+            {
+                return;
+            }
+
+            m_enabled = true;
+            m_event.category = category;
+            m_event.name = name;
+            m_event.ns = ns;
+            m_event.thread = profile.thread_index();
+            m_event.start = profile.now();
+            m_writer = w;
+            m_bytes = w ? w->bytes_written() : 0;
+            m_allocations = allocation_count;
+        }
+
+        ~profile_scope() noexcept
+        {
+            if (!m_enabled)
+            {
+                return;
+            }
+
+            try
+            {
+                m_event.duration = profile.now() - m_event.start;
+                m_event.bytes = m_writer ? m_writer->bytes_written() - m_bytes : 0;
+                m_event.allocations = allocation_count - m_allocations;
+                profile.add(std::move(m_event));
+            }
+            catch (...)
+            {
+                // Profiling is best effort and must not turn into a failure of its own.
+            }
+        }
+
+    private:
+
+        bool m_enabled{};
+        profiler::event m_event;
+        writer const* m_writer{};
+        uint64_t m_bytes{};
+        uint64_t m_allocations{};
+    };
+
+    template <auto F, typename List, typename... Args>
+    void profile_each(writer& w, std::string_view const& name, List const& list, Args const&... args)
+    {
+        profile_scope scope{ "writer", name, &w };
+        w.write_each<F>(list, args...);
+    }
+}
@@ -0,0 +1,405 @@
+#pragma once
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace cppwinrt
+{
+    // A generation request forwarded by -connect to a -server process. The arguments are passed through unchanged
+    // and parsed by the server with the same reader and options, relative to the client's working directory.
+    struct server_request
+    {
+        std::string directory;
+        std::vector<std::string> args;
+
+        std::string encode() const
+        {
+            std::string result{ directory };
+
+            for (auto&& arg : args)
+            {
+                result += '\0';
+                result += arg;
+            }
+
+            return result;
+        }
+
+        static server_request decode(std::string_view message)
+        {
+            server_request result;
+            auto end = message.find('\0');
+            result.directory = message.substr(0, end);
+
+            while (end != std::string_view::npos)
+            {
+                message = message.substr(end + 1);
+                end = message.find('\0');
+                result.args.emplace_back(message.substr(0, end));
+            }
+
+            return result;
+        }
+    };
+
+    struct server_response
+    {
+        int32_t result{};
+        std::string output;
+
+        std::string encode() const
+        {
+            std::string message(sizeof(result), '\0');
+            memcpy(message.data(), &result, sizeof(result));
+            message += output;
+            return message;
+        }
+
+        static bool decode(std::string_view const& message, server_response& response)
+        {
+            if (message.size() < sizeof(response.result))
+            {
+                return false;
+            }
+
+            memcpy(&response.result, message.data(), sizeof(response.result));
+            response.output = message.substr(sizeof(response.result));
+            return true;
+        }
+    };
+
+    // One end of a connected local socket, or a named pipe instance on Windows, carrying length-prefixed messages.
+    struct local_connection
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        using handle_type = HANDLE;
+#else
+        using handle_type = int;
+#endif
+
+        local_connection(local_connection const&) = delete;
+        local_connection& operator=(local_connection const&) = delete;
+
+        local_connection() noexcept = default;
+
+        local_connection(handle_type handle, bool server) noexcept : m_handle(handle), m_server(server)
+        {
+        }
+
+        local_connection(local_connection&& other) noexcept :
+            m_handle(std::exchange(other.m_handle, invalid_handle())),
+            m_server(other.m_server)
+        {
+        }
+
+        ~local_connection() noexcept
+        {
+            close();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_handle != invalid_handle();
+        }
+
+        // Returns an unconnected object if no server is listening under the given name.
+        static local_connection connect(std::string const& name)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            auto const pipe = pipe_name(name);
+
+            while (true)
+            {
+                HANDLE handle = CreateFileA(pipe.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+
+                if (handle != INVALID_HANDLE_VALUE)
+                {
+                    return { handle, false };
+                }
+
+                // The server always keeps an instance waiting for the next client, so a busy pipe only means that
+                // another client got there first.
+                if (GetLastError() != ERROR_PIPE_BUSY || !WaitNamedPipeA(pipe.c_str(), 30000))
+                {
+                    return {};
+                }
+            }
+#else
+            sockaddr_un address{};
+
+            if (!socket_address(name, address))
+            {
+                return {};
+            }
+
+            local_connection result{ ::socket(AF_UNIX, SOCK_STREAM, 0), false };
+
+            if (!result || ::connect(result.m_handle, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0)
+            {
+                return {};
+            }
+
+            return result;
+#endif
+        }
+
+        bool send(std::string_view const& message)
+        {
+            uint64_t const size = message.size();
+            return write(&size, sizeof(size)) && write(message.data(), message.size());
+        }
+
+        bool receive(std::string& message)
+        {
+            uint64_t size{};
+
+            if (!read(&size, sizeof(size)) || size > max_message_size)
+            {
+                return false;
+            }
+
+            message.resize(static_cast<size_t>(size));
+            return read(message.data(), message.size());
+        }
+
+#if defined(_WIN32) || defined(_WIN64)
+        static std::string pipe_name(std::string const& name)
+        {
+            return R"(\\.\pipe\)" + name;
+        }
+#else
+        static bool socket_address(std::string const& name, sockaddr_un& address) noexcept
+        {
+            if (name.empty() || name.size() >= sizeof(address.sun_path))
+            {
+                return false;
+            }
+
+            address.sun_family = AF_UNIX;
+            memcpy(address.sun_path, name.c_str(), name.size() + 1);
+            return true;
+        }
+#endif
+
+    private:
+
+        static constexpr uint64_t max_message_size{ 256 * 1024 * 1024 };
+
+        static handle_type invalid_handle() noexcept
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            return INVALID_HANDLE_VALUE;
+#else
+            return -1;
+#endif
+        }
+
+        bool read(void* data, size_t size)
+        {
+            auto buffer = static_cast<char*>(data);
+
+            while (size)
+            {
+#if defined(_WIN32) || defined(_WIN64)
+                DWORD count{};
+
+                if (!ReadFile(m_handle, buffer, static_cast<DWORD>((std::min)(size, size_t{ 64 * 1024 })), &count, nullptr) || count == 0)
+                {
+                    return false;
+                }
+#else
+                auto const count = ::recv(m_handle, buffer, size, 0);
+
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (count <= 0)
+                {
+                    return false;
+                }
+#endif
+                buffer += count;
+                size -= static_cast<size_t>(count);
+            }
+
+            return true;
+        }
+
+        bool write(void const* data, size_t size)
+        {
+            auto buffer = static_cast<char const*>(data);
+
+            while (size)
+            {
+#if defined(_WIN32) || defined(_WIN64)
+                DWORD count{};
+
+                if (!WriteFile(m_handle, buffer, static_cast<DWORD>((std::min)(size, size_t{ 64 * 1024 })), &count, nullptr))
+                {
+                    return false;
+                }
+#else
+#if defined(MSG_NOSIGNAL)
+                // A client that has gone away must not take the server down with SIGPIPE.
+                auto const count = ::send(m_handle, buffer, size, MSG_NOSIGNAL);
+#else
+                auto const count = ::send(m_handle, buffer, size, 0);
+#endif
+
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (count < 0)
+                {
+                    return false;
+                }
+#endif
+                buffer += count;
+                size -= static_cast<size_t>(count);
+            }
+
+            return true;
+        }
+
+        void close() noexcept
+        {
+            if (m_handle == invalid_handle())
+            {
+                return;
+            }
+
+#if defined(_WIN32) || defined(_WIN64)
+            if (m_server)
+            {
+                FlushFileBuffers(m_handle);
+                DisconnectNamedPipe(m_handle);
+            }
+
+            CloseHandle(m_handle);
+#else
+            ::close(m_handle);
+#endif
+            m_handle = invalid_handle();
+        }
+
+        handle_type m_handle{ invalid_handle() };
+        bool m_server{};
+    };
+
+    // Listens for -connect clients under a name that is a socket path, or a pipe name on Windows.
+    struct local_listener
+    {
+        local_listener(local_listener const&) = delete;
+        local_listener& operator=(local_listener const&) = delete;
+
+        explicit local_listener(std::string name) : m_name(std::move(name))
+        {
+#if !defined(_WIN32) && !defined(_WIN64)
+            sockaddr_un address{};
+
+            if (!local_connection::socket_address(m_name, address))
+            {
+                throw_invalid("Invalid server socket path '", m_name, "'");
+            }
+
+            m_socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+            if (m_socket == -1)
+            {
+                throw_invalid("Cannot create server socket '", m_name, "'");
+            }
+
+            // A socket left behind by a server that didn't shut down cleanly would otherwise fail the bind.
+            ::unlink(m_name.c_str());
+
+            if (::bind(m_socket, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 || ::listen(m_socket, SOMAXCONN) != 0)
+            {
+                ::close(m_socket);
+                throw_invalid("Cannot listen on server socket '", m_name, "'");
+            }
+#else
+            m_pending = create_instance();
+#endif
+        }
+
+        ~local_listener() noexcept
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            if (m_pending != INVALID_HANDLE_VALUE)
+            {
+                CloseHandle(m_pending);
+            }
+#else
+            ::close(m_socket);
+            ::unlink(m_name.c_str());
+#endif
+        }
+
+        local_connection accept()
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            HANDLE handle = std::exchange(m_pending, INVALID_HANDLE_VALUE);
+            local_connection result{ handle, true };
+            bool const connected = ConnectNamedPipe(handle, nullptr) || GetLastError() == ERROR_PIPE_CONNECTED;
+
+            // A pipe name only exists while it has an instance, and a client that finds none gives up and generates
+            // locally. So the next instance is created before this one is handed out, and clients arriving while a
+            // request is handled connect to it and wait their turn.
+            m_pending = create_instance();
+
+            if (!connected)
+            {
+                return {};
+            }
+
+            return result;
+#else
+            while (true)
+            {
+                int const handle = ::accept(m_socket, nullptr, nullptr);
+
+                if (handle != -1)
+                {
+                    return { handle, true };
+                }
+
+                if (errno != EINTR && errno != ECONNABORTED)
+                {
+                    throw_invalid("Cannot accept on server socket '", m_name, "'");
+                }
+            }
+#endif
+        }
+
+    private:
+
+#if defined(_WIN32) || defined(_WIN64)
+        HANDLE create_instance() const
+        {
+            auto const pipe = local_connection::pipe_name(m_name);
+            HANDLE handle = CreateNamedPipeA(pipe.c_str(), PIPE_ACCESS_DUPLEX, PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS, PIPE_UNLIMITED_INSTANCES, 64 * 1024, 64 * 1024, 0, nullptr);
+
+            if (handle == INVALID_HANDLE_VALUE)
+            {
+                throw_invalid("Cannot create server pipe '", pipe, "'");
+            }
+
+            return handle;
+        }
+#endif
+
+        std::string m_name;
+#if defined(_WIN32) || defined(_WIN64)
+        HANDLE m_pending{ INVALID_HANDLE_VALUE };
+#else
+        int m_socket{ -1 };
+#endif
+    };
+}
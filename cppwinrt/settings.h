@@ -29,6 +29,11 @@ namespace cppwinrt
         winmd::reader::filter projection_filter;
         winmd::reader::filter component_filter;
 
+        uint32_t jobs{};
+        bool incremental{};
+        std::string reference_index;
+        std::string deps;
+
         bool fastabi{};
         std::map<winmd::reader::TypeDef, winmd::reader::TypeDef> fastabi_cache;
     };
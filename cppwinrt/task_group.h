@@ -1,9 +1,31 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 namespace cppwinrt
 {
+    // A bounded work-stealing pool. Each worker owns a queue that it drains LIFO while other workers
+    // steal from the opposite end, so the number of OS threads stays at the job count no matter how
+    // many tasks are added.
     struct task_group
     {
+        struct task_timing
+        {
+            std::string name;
+            int64_t elapsed{};
+        };
+
         task_group(task_group const&) = delete;
         task_group& operator=(task_group const&) = delete;
 
@@ -11,9 +33,18 @@ namespace cppwinrt
 
         ~task_group() noexcept
         {
-            for (auto&& task : m_tasks)
+            wait();
+
+            {
+                std::lock_guard lock(m_lock);
+                m_stopping = true;
+            }
+
+            m_wake.notify_all();
+
+            for (auto&& thread : m_threads)
             {
-                task.wait();
+                thread.join();
             }
         }
 
@@ -22,37 +53,237 @@ namespace cppwinrt
             m_synchronous = synchronous;
         }
 
+        // Sets the maximum number of worker threads. Zero (the default) uses the hardware concurrency.
+        void jobs(uint32_t jobs) noexcept
+        {
+            m_jobs = jobs;
+        }
+
+        uint32_t jobs() const noexcept
+        {
+            if (m_synchronous)
+            {
+                return 1;
+            }
+
+            return m_jobs ? m_jobs : (std::max)(1u, std::thread::hardware_concurrency());
+        }
+
         template <typename T>
         void add(T&& callback)
         {
+            add({}, std::forward<T>(callback));
+        }
+
+        template <typename T>
+        void add(std::string name, T&& callback)
+        {
+            task item{ std::move(name), std::forward<T>(callback) };
+
             if (m_synchronous)
             {
-                callback();
+                run(item);
+                rethrow();
+                return;
             }
-            else
+
+            start();
+            ++m_pending;
+
+            // Tasks added by a worker go to the back of its own queue so that they run next on a warm
+            // core, while tasks added from outside the pool are spread round-robin across the workers.
+            worker& target = *m_workers[t_current == this ? t_index : m_next++ % m_workers.size()];
+
+            {
+                std::lock_guard lock(target.lock);
+                target.tasks.push_back(std::move(item));
+            }
+
             {
-                m_tasks.push_back(std::async(std::forward<T>(callback)));
+                std::lock_guard lock(m_lock);
+                ++m_signal;
             }
+
+            m_wake.notify_one();
         }
 
         void get()
         {
-            auto tasks = std::move(m_tasks);
+            wait();
+            rethrow();
+        }
+
+        std::vector<task_timing> timings() const
+        {
+            std::lock_guard lock(m_lock);
+            return m_timings;
+        }
+
+    private:
 
-            for (auto&& task : tasks)
+        struct task
+        {
+            std::string name;
+            std::function<void()> callback;
+        };
+
+        struct worker
+        {
+            std::mutex lock;
+            std::deque<task> tasks;
+        };
+
+        void start()
+        {
+            if (!m_workers.empty())
             {
-                task.wait();
+                return;
             }
 
-            for (auto&& task : tasks)
+            auto const count = jobs();
+
+            for (uint32_t index = 0; index < count; ++index)
             {
-                task.get();
+                m_workers.push_back(std::make_unique<worker>());
+            }
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                m_threads.emplace_back([this, index] { work(index); });
             }
         }
 
-    private:
+        bool pop(uint32_t index, task& item)
+        {
+            {
+                worker& self = *m_workers[index];
+                std::lock_guard lock(self.lock);
+
+                if (!self.tasks.empty())
+                {
+                    item = std::move(self.tasks.back());
+                    self.tasks.pop_back();
+                    return true;
+                }
+            }
+
+            for (size_t offset = 1; offset < m_workers.size(); ++offset)
+            {
+                worker& victim = *m_workers[(index + offset) % m_workers.size()];
+                std::lock_guard lock(victim.lock);
+
+                if (!victim.tasks.empty())
+                {
+                    item = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void work(uint32_t index)
+        {
+            t_current = this;
+            t_index = index;
+
+            while (true)
+            {
+                uint64_t signal;
+
+                {
+                    std::lock_guard lock(m_lock);
+                    signal = m_signal;
+                }
+
+                task item;
+
+                if (pop(index, item))
+                {
+                    run(item);
+
+                    if (--m_pending == 0)
+                    {
+                        std::lock_guard lock(m_lock);
+                        m_idle.notify_all();
+                    }
+
+                    continue;
+                }
+
+                std::unique_lock lock(m_lock);
+                m_wake.wait(lock, [&] { return m_stopping || m_signal != signal; });
+
+                if (m_stopping)
+                {
+                    return;
+                }
+            }
+        }
+
+        void run(task& item)
+        {
+            auto const start = std::chrono::steady_clock::now();
+
+            try
+            {
+                item.callback();
+            }
+            catch (...)
+            {
+                std::lock_guard lock(m_lock);
+
+                if (!m_exception)
+                {
+                    m_exception = std::current_exception();
+                }
+            }
+
+            if (!item.name.empty())
+            {
+                auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+                std::lock_guard lock(m_lock);
+                m_timings.push_back({ std::move(item.name), elapsed });
+            }
+        }
+
+        void wait() noexcept
+        {
+            std::unique_lock lock(m_lock);
+            m_idle.wait(lock, [&] { return m_pending == 0; });
+        }
+
+        void rethrow()
+        {
+            std::exception_ptr exception;
+
+            {
+                std::lock_guard lock(m_lock);
+                std::swap(exception, m_exception);
+            }
+
+            if (exception)
+            {
+                std::rethrow_exception(exception);
+            }
+        }
+
+        static inline thread_local task_group* t_current{};
+        static inline thread_local uint32_t t_index{};
 
-        std::vector<std::future<void>> m_tasks;
+        std::vector<std::unique_ptr<worker>> m_workers;
+        std::vector<std::thread> m_threads;
+        mutable std::mutex m_lock;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::atomic<size_t> m_pending{};
+        uint64_t m_signal{};
+        size_t m_next{};
+        bool m_stopping{};
         bool m_synchronous{};
+        uint32_t m_jobs{};
+        std::exception_ptr m_exception;
+        std::vector<task_timing> m_timings;
     };
 }
@@ -1,13 +1,28 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <random>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 namespace cppwinrt
 {
     inline std::string file_to_string(std::string const& filename)
@@ -16,20 +31,195 @@ namespace cppwinrt
         return static_cast<std::stringstream const&>(std::stringstream() << file.rdbuf()).str();
     }
 
+    // A segmented buffer of fixed-size chunks. Appending never moves previously written text, so large
+    // headers grow without the repeated reallocation and copying of a contiguous vector.
+    struct chunked_buffer
+    {
+        static constexpr size_t chunk_size = 16 * 1024;
+
+        void append(std::string_view value)
+        {
+            while (!value.empty())
+            {
+                auto const offset = m_size % chunk_size;
+
+                if (offset == 0 && m_size == m_chunks.size() * chunk_size)
+                {
+                    m_chunks.emplace_back(new char[chunk_size]);
+                }
+
+                auto const count = (std::min)(chunk_size - offset, value.size());
+                std::copy_n(value.data(), count, m_chunks.back().get() + offset);
+                value.remove_prefix(count);
+                m_size += count;
+            }
+        }
+
+        void push_back(char const value)
+        {
+            append({ &value, 1 });
+        }
+
+        size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        char back() const noexcept
+        {
+            assert(!empty());
+            return m_chunks[(m_size - 1) / chunk_size][(m_size - 1) % chunk_size];
+        }
+
+        // Copies the text from offset to the end of the buffer.
+        void copy(size_t offset, std::string& result) const
+        {
+            assert(offset <= m_size);
+            result.reserve(result.size() + m_size - offset);
+
+            while (offset < m_size)
+            {
+                auto const count = (std::min)(chunk_size - offset % chunk_size, m_size - offset);
+                result.append(m_chunks[offset / chunk_size].get() + offset % chunk_size, count);
+                offset += count;
+            }
+        }
+
+        // Discards the text beyond size, releasing any chunks that are no longer needed.
+        void truncate(size_t size) noexcept
+        {
+            assert(size <= m_size);
+            m_size = size;
+            m_chunks.resize((m_size + chunk_size - 1) / chunk_size);
+        }
+
+        void clear() noexcept
+        {
+            truncate(0);
+        }
+
+        // Calls the callback with each contiguous segment of the buffer, in order.
+        template <typename F>
+        bool each_segment(F&& callback) const
+        {
+            for (size_t index = 0; index < m_chunks.size(); ++index)
+            {
+                if (!callback(std::string_view{ m_chunks[index].get(), (std::min)(chunk_size, m_size - index * chunk_size) }))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        void swap(chunked_buffer& other) noexcept
+        {
+            std::swap(m_chunks, other.m_chunks);
+            std::swap(m_size, other.m_size);
+        }
+
+    private:
+
+        std::vector<std::unique_ptr<char[]>> m_chunks;
+        size_t m_size{};
+    };
+
+#if defined(__cpp_consteval)
+#define CPPWINRT_CONSTEVAL consteval
+#else
+#define CPPWINRT_CONSTEVAL constexpr
+#endif
+
+    // A format string split into its literal runs and placeholders. When the compiler supports consteval the split
+    // happens at compile time and a placeholder count that does not match the arguments is a compile-time error.
+    template <size_t Count>
+    struct format_string
+    {
+        template <size_t Size>
+        CPPWINRT_CONSTEVAL format_string(char const (&value)[Size]) noexcept
+        {
+            size_t const size = Size - 1;
+            size_t start{};
+            size_t index{};
+            bool escape{};
+
+            for (size_t offset = 0; offset != size; ++offset)
+            {
+                if (escape)
+                {
+                    escape = false;
+                    continue;
+                }
+
+                if (value[offset] == '^')
+                {
+                    escaped[index] = true;
+                    escape = true;
+                    continue;
+                }
+
+                if (value[offset] == '%' || value[offset] == '@')
+                {
+                    if (index == Count)
+                    {
+                        placeholder_count_mismatch();
+                        return;
+                    }
+
+                    text[index] = { value + start, offset - start };
+                    code[index] = value[offset] == '@';
+                    start = offset + 1;
+                    ++index;
+                }
+            }
+
+            if (index != Count)
+            {
+                placeholder_count_mismatch();
+            }
+
+            text[index] = { value + start, size - start };
+        }
+
+        std::array<std::string_view, Count + 1> text{};
+        std::array<bool, Count + 1> escaped{};
+        std::array<bool, Count> code{};
+
+    private:
+
+        // Not constexpr, so reaching it during constant evaluation fails to compile.
+        static void placeholder_count_mismatch() noexcept
+        {
+            assert(false);
+        }
+    };
+
     template <typename T>
     struct writer_base
     {
         writer_base(writer_base const&) = delete;
         writer_base& operator=(writer_base const&) = delete;
 
-        writer_base()
+        writer_base() = default;
+
+        // String literal formats are parsed once, up front, so that writing them is a straight sequence of appends.
+        template <typename... Args, std::enable_if_t<(sizeof...(Args) > 0), int> = 0>
+        void write(format_string<sizeof...(Args)> const& format, Args const&... args)
         {
-            m_first.reserve(16 * 1024);
+            write_format(format, std::index_sequence_for<Args...>{}, args...);
         }
 
-        template <typename... Args>
-        void write(std::string_view const& value, Args const&... args)
+        // Formats that are only known at run time are scanned as they are written.
+        template <typename S, typename... Args, std::enable_if_t<(sizeof...(Args) > 0) && !std::is_array_v<S> && std::is_convertible_v<S const&, std::string_view>, int> = 0>
+        void write(S const& format, Args const&... args)
         {
+            std::string_view const value{ format };
 #if defined(_DEBUG)
             auto expected = count_placeholders(value);
             auto actual = sizeof...(Args);
@@ -50,8 +240,9 @@ namespace cppwinrt
             assert(count_placeholders(value) == sizeof...(Args));
             write_segment(value, args...);
 
-            std::string result{ m_first.data() + size, m_first.size() - size };
-            m_first.resize(size);
+            std::string result;
+            m_first.copy(size, result);
+            m_first.truncate(size);
 
 #if defined(_DEBUG)
             debug_trace = restore_debug_trace;
@@ -61,7 +252,7 @@ namespace cppwinrt
 
         void write_impl(std::string_view const& value)
         {
-            m_first.insert(m_first.end(), value.begin(), value.end());
+            m_first.append(value);
 
 #if defined(_DEBUG)
             if (debug_trace)
@@ -162,13 +353,20 @@ namespace cppwinrt
 
         void swap() noexcept
         {
-            std::swap(m_second, m_first);
+            m_second.swap(m_first);
         }
 
         void flush_to_console(bool to_stdout = true) noexcept
         {
-            fprintf(to_stdout ? stdout : stderr, "%.*s", static_cast<int>(m_first.size()), m_first.data());
-            fprintf(to_stdout ? stdout : stderr, "%.*s", static_cast<int>(m_second.size()), m_second.data());
+            auto print = [stream = to_stdout ? stdout : stderr](std::string_view const& segment)
+            {
+                fwrite(segment.data(), 1, segment.size(), stream);
+                return true;
+            };
+
+            m_first.each_segment(print);
+            m_second.each_segment(print);
+            m_flushed += m_first.size() + m_second.size();
             m_first.clear();
             m_second.clear();
         }
@@ -177,19 +375,22 @@ namespace cppwinrt
         {
             if (!file_equal(filename))
             {
-                std::ofstream file;
-                file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-                try
-                {
-                  file.open(filename, std::ios::out | std::ios::binary);
-                  file.write(m_first.data(), m_first.size());
-                  file.write(m_second.data(), m_second.size());
-                }
-                catch (std::ofstream::failure const& e)
+                // Write to a sibling temporary file and rename it over the target so that an interrupted
+                // build can never leave a partially written file behind.
+                auto const temp = temp_filename(filename);
+                write_file(temp);
+
+                std::error_code error;
+                std::filesystem::rename(temp, filename, error);
+
+                if (error)
                 {
-                  throw std::filesystem::filesystem_error(e.what(), filename, std::io_errc::stream);
+                    std::error_code ignored;
+                    std::filesystem::remove(temp, ignored);
+                    throw std::filesystem::filesystem_error("Cannot replace file", filename, error);
                 }
             }
+            m_flushed += m_first.size() + m_second.size();
             m_first.clear();
             m_second.clear();
         }
@@ -203,13 +404,20 @@ namespace cppwinrt
         {
             std::string result;
             result.reserve(m_first.size() + m_second.size());
-            result.assign(m_first.begin(), m_first.end());
-            result.append(m_second.begin(), m_second.end());
+            m_first.copy(0, result);
+            m_second.copy(0, result);
+            m_flushed += result.size();
             m_first.clear();
             m_second.clear();
             return result;
         }
 
+        // The number of bytes written so far, including any that have already been flushed.
+        uint64_t bytes_written() const noexcept
+        {
+            return m_flushed + m_first.size() + m_second.size();
+        }
+
         char back()
         {
             return m_first.empty() ? char{} : m_first.back();
@@ -217,24 +425,24 @@ namespace cppwinrt
 
         bool file_equal(std::string const& filename) const
         {
-            if (!std::filesystem::exists(filename))
-            {
-                return false;
-            }
+            std::error_code error;
+            auto const size = std::filesystem::file_size(filename, error);
 
-            auto file = file_to_string(filename);
-
-            if (file.size() != m_first.size() + m_second.size())
+            if (error || size != m_first.size() + m_second.size())
             {
                 return false;
             }
 
-            if (!std::equal(m_first.begin(), m_first.end(), file.begin(), file.begin() + m_first.size()))
+            // Compare one segment at a time so that existing files are never read into memory in full.
+            std::ifstream file(filename, std::ios::binary);
+            std::array<char, chunked_buffer::chunk_size> chunk;
+
+            auto compare = [&](std::string_view const& segment)
             {
-                return false;
-            }
+                return file.read(chunk.data(), segment.size()) && std::equal(segment.begin(), segment.end(), chunk.data());
+            };
 
-            return std::equal(m_second.begin(), m_second.end(), file.begin() + m_first.size(), file.end());
+            return m_first.each_segment(compare) && m_second.each_segment(compare);
         }
 
 #if defined(_DEBUG)
@@ -243,6 +451,98 @@ namespace cppwinrt
 
     private:
 
+        void write_file(std::string const& filename) const
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            std::ofstream file;
+            file.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+            try
+            {
+              file.open(filename, std::ios::out | std::ios::binary);
+
+              auto write = [&](std::string_view const& segment)
+              {
+                  file.write(segment.data(), segment.size());
+                  return true;
+              };
+
+              m_first.each_segment(write);
+              m_second.each_segment(write);
+              file.close();
+            }
+            catch (std::ofstream::failure const& e)
+            {
+              std::error_code ignored;
+              std::filesystem::remove(filename, ignored);
+              throw std::filesystem::filesystem_error(e.what(), filename, std::io_errc::stream);
+            }
+#else
+            // Hand every segment to the kernel in as few writev calls as possible.
+            std::vector<iovec> segments;
+
+            auto gather = [&](std::string_view const& segment)
+            {
+                segments.push_back({ const_cast<char*>(segment.data()), segment.size() });
+                return true;
+            };
+
+            m_first.each_segment(gather);
+            m_second.each_segment(gather);
+
+            int const file = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+            size_t index{};
+
+            while (file != -1 && index != segments.size())
+            {
+                auto const count = (std::min)(segments.size() - index, size_t{ IOV_MAX });
+                auto written = ::writev(file, segments.data() + index, static_cast<int>(count));
+
+                if (written == -1)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+
+                    break;
+                }
+
+                // Skip fully written segments and trim a partially written one.
+                while (index != segments.size() && static_cast<size_t>(written) >= segments[index].iov_len)
+                {
+                    written -= segments[index].iov_len;
+                    ++index;
+                }
+
+                if (written)
+                {
+                    segments[index].iov_base = static_cast<char*>(segments[index].iov_base) + written;
+                    segments[index].iov_len -= written;
+                }
+            }
+
+            int error = file == -1 || index != segments.size() ? errno : 0;
+
+            if (file != -1 && ::close(file) == -1 && !error)
+            {
+                error = errno;
+            }
+
+            if (error)
+            {
+                std::error_code ignored;
+                std::filesystem::remove(filename, ignored);
+                throw std::filesystem::filesystem_error("Cannot write file", filename, std::error_code{ error, std::generic_category() });
+            }
+#endif
+        }
+
+        static std::string temp_filename(std::string const& filename)
+        {
+            static std::atomic<uint32_t> counter{ std::random_device{}() };
+            return filename + '.' + std::to_string(counter++) + ".tmp";
+        }
+
         static constexpr uint32_t count_placeholders(std::string_view const& format) noexcept
         {
             uint32_t count{};
@@ -269,6 +569,42 @@ namespace cppwinrt
             return count;
         }
 
+        template <size_t Count, size_t... Index, typename... Args>
+        void write_format(format_string<Count> const& format, std::index_sequence<Index...>, Args const&... args)
+        {
+            ((write_literal(format.text[Index], format.escaped[Index]), write_argument(format.code[Index], args)), ...);
+            write_literal(format.text[Count], format.escaped[Count]);
+        }
+
+        void write_literal(std::string_view const& value, bool escaped)
+        {
+            if (escaped)
+            {
+                write_segment(value);
+            }
+            else if (!value.empty())
+            {
+                write(value);
+            }
+        }
+
+        template <typename Arg>
+        void write_argument(bool code, Arg const& arg)
+        {
+            if (!code)
+            {
+                static_cast<T*>(this)->write(arg);
+            }
+            else if constexpr (std::is_convertible_v<Arg, std::string_view>)
+            {
+                static_cast<T*>(this)->write_code(arg);
+            }
+            else
+            {
+                assert(false); // '@' placeholders are only for text.
+            }
+        }
+
         void write_segment(std::string_view const& value)
         {
             auto offset = value.find_first_of("^");
@@ -322,8 +658,9 @@ namespace cppwinrt
             }
         }
 
-        std::vector<char> m_second;
-        std::vector<char> m_first;
+        chunked_buffer m_second;
+        chunked_buffer m_first;
+        uint64_t m_flushed{};
     };
 
 
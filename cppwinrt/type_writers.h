@@ -123,6 +123,7 @@ namespace cppwinrt
         bool consume_types{};
         bool async_types{};
         std::map<std::string_view, std::set<TypeDef, depends_compare>> depends;
+        std::vector<std::string> includes;
         std::vector<std::vector<std::string>> generic_param_stack;
 
         struct generic_param_guard
@@ -555,9 +556,10 @@ namespace cppwinrt
 
         void write_root_include(std::string_view const& include)
         {
-            auto format = R"(#include %winrt/%.h%
+            static constexpr char format[] = R"(#include %winrt/%.h%
 )";
 
+            includes.emplace_back(include);
             write(format,
                 settings.brackets ? '<' : '\"',
                 include,
@@ -576,6 +578,18 @@ namespace cppwinrt
             }
         }
 
+        std::vector<std::string_view> depends_namespaces() const
+        {
+            std::vector<std::string_view> result;
+
+            for (auto&& [ns, types] : depends)
+            {
+                result.push_back(ns);
+            }
+
+            return result;
+        }
+
         void save_header(char impl = 0)
         {
             auto filename{ settings.output_folder + "winrt/" };
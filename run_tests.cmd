@@ -12,6 +12,8 @@ call :run_test test
 call :run_test test_cpp20
 call :run_test test_cpp20_no_sourcelocation
 call :run_test test_fast
+call :run_test test_fast_hash
+call :run_test test_delegate_storage
 call :run_test test_slow
 call :run_test test_old
 call :run_test test_module_lock_custom
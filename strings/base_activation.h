@@ -308,7 +308,25 @@ namespace winrt::impl
 #if !defined _M_IX86 && !defined _M_X64 && !defined _M_ARM64
 #error Unsupported architecture: verify that zero-initialization of SLIST_HEADER is still safe
 #endif
+}
+
+WINRT_EXPORT namespace winrt
+{
+    struct factory_cache_statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t contention;
+    };
+}
 
+namespace winrt::impl
+{
+    // The factory cache keeps two independent sets of factories. Each class activated by type has its own
+    // factory_cache_entry, which is found without any lookup. Separately, agile factories requested through
+    // get_cached_activation_factory are kept by class name in a number of shards, each with its own lock, so that
+    // activation by name rarely contends. The cache is never destroyed, so that factories are not released after COM
+    // has been torn down at process exit.
     struct factory_cache
     {
         factory_cache(factory_cache const&) = delete;
@@ -333,13 +351,193 @@ namespace winrt::impl
                 reinterpret_cast<factory_cache_entry_base*>(reinterpret_cast<uint8_t*>(entry) - offsetof(factory_cache_entry_base, m_next))->clear();
                 entry = next;
             }
+
+            // The named factories are only cached on request, so they are released even without a module lock.
+            for (auto&& shard : m_shards)
+            {
+                name_entry* first{};
+
+                {
+                    slim_lock_guard const guard(shard.lock);
+                    first = std::exchange(shard.first, nullptr);
+                }
+
+                // The factories are released outside of the lock, since releasing one may run arbitrary code.
+                while (first != nullptr)
+                {
+                    name_entry* next = first->next;
+                    first->object->Release();
+                    delete first;
+                    first = next;
+                }
+            }
+        }
+
+        // Finds the agile factory for the named class, activating it and caching it on first use.
+        template <typename Interface>
+        hresult get(param::hstring const& name, void** result)
+        {
+            hstring const& class_name = name;
+            auto& shard = m_shards[std::hash<std::wstring_view>{}(class_name) % shard_count];
+            guid const& iid = guid_of<Interface>();
+
+            if (unknown_abi* object = find(shard, class_name, iid))
+            {
+                count(&counter_slot::hits);
+                *result = object;
+                return 0;
+            }
+
+            // A factory preloaded as IActivationFactory also provides the class's other factory interfaces.
+            if constexpr (!std::is_same_v<Interface, Windows::Foundation::IActivationFactory>)
+            {
+                if (unknown_abi* object = find(shard, class_name, guid_of<Windows::Foundation::IActivationFactory>()))
+                {
+                    hresult const hr = object->QueryInterface(iid, result);
+                    object->Release();
+
+                    if (hr == 0)
+                    {
+                        count(&counter_slot::hits);
+                        insert(shard, class_name, iid, static_cast<unknown_abi*>(*result));
+                        return 0;
+                    }
+                }
+            }
+
+            count(&counter_slot::misses);
+            hresult const hr = get_runtime_activation_factory<Interface>(name, result);
+
+            if (hr == 0 && is_agile(static_cast<unknown_abi*>(*result)))
+            {
+                insert(shard, class_name, iid, static_cast<unknown_abi*>(*result));
+            }
+
+            return hr;
+        }
+
+        factory_cache_statistics statistics() const noexcept
+        {
+            factory_cache_statistics result{};
+
+            for (auto&& slot : m_counters)
+            {
+                result.hits += slot.hits.load(std::memory_order_relaxed);
+                result.misses += slot.misses.load(std::memory_order_relaxed);
+                result.contention += slot.contention.load(std::memory_order_relaxed);
+            }
+
+            return result;
         }
 
     private:
 
+        static constexpr uint32_t shard_count{ 16 };
+        static constexpr uint32_t slot_count{ 8 };
+
+        struct name_entry
+        {
+            name_entry* next;
+            hstring name;
+            guid iid;
+            unknown_abi* object;
+        };
+
+        struct alignas(64) shard_type
+        {
+            slim_mutex lock;
+            name_entry* first{};
+        };
+
+        // The counters are spread over several cache lines so that threads activating at the same time don't all
+        // update the same one.
+        struct alignas(64) counter_slot
+        {
+            std::atomic<uint64_t> hits{};
+            std::atomic<uint64_t> misses{};
+            std::atomic<uint64_t> contention{};
+        };
+
+        void count(std::atomic<uint64_t> counter_slot::* counter) noexcept
+        {
+            (m_counters[thread_slot_index() % slot_count].*counter).fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static bool is_agile(unknown_abi* object) noexcept
+        {
+            void* agile{};
+
+            if (0 != object->QueryInterface(guid_of<IAgileObject>(), &agile))
+            {
+                return false;
+            }
+
+            static_cast<unknown_abi*>(agile)->Release();
+            return true;
+        }
+
+        static name_entry* find_locked(shard_type const& shard, std::wstring_view const& name, guid const& iid) noexcept
+        {
+            for (name_entry* entry = shard.first; entry != nullptr; entry = entry->next)
+            {
+                if (entry->iid == iid && std::wstring_view{ entry->name } == name)
+                {
+                    return entry;
+                }
+            }
+
+            return nullptr;
+        }
+
+        // Returns an AddRef'd factory, or nullptr if none is cached.
+        unknown_abi* find(shard_type& shard, std::wstring_view const& name, guid const& iid) noexcept
+        {
+            if (!shard.lock.try_lock_shared())
+            {
+                count(&counter_slot::contention);
+                shard.lock.lock_shared();
+            }
+
+            unknown_abi* object{};
+
+            if (name_entry* entry = find_locked(shard, name, iid))
+            {
+                object = entry->object;
+                object->AddRef();
+            }
+
+            shard.lock.unlock_shared();
+            return object;
+        }
+
+        void insert(shard_type& shard, hstring const& name, guid const& iid, unknown_abi* object)
+        {
+            std::unique_ptr<name_entry> entry(new name_entry{ nullptr, name, iid, object });
+
+            if (!shard.lock.try_lock())
+            {
+                count(&counter_slot::contention);
+                shard.lock.lock();
+            }
+
+            // Another thread may have cached the same factory in the meantime, in which case this one is dropped.
+            if (!find_locked(shard, name, iid))
+            {
+                object->AddRef();
+                entry->next = shard.first;
+                shard.first = entry.release();
+            }
+
+            shard.lock.unlock();
+        }
+
         alignas(memory_allocation_alignment) slist_header m_list;
+        shard_type m_shards[shard_count];
+        counter_slot m_counters[slot_count];
     };
 
+    static_assert(std::is_trivially_destructible_v<factory_cache>);
+
     inline factory_cache& get_factory_cache() noexcept
     {
         static factory_cache cache;
@@ -513,11 +711,28 @@ WINRT_EXPORT namespace winrt
         return impl::try_get_activation_factory<Interface>(name, &exception);
     }
 
+    // Like get_activation_factory, but keeps agile factories by class name until clear_factory_cache is called. Later
+    // requests for a cached class are served from the cache, so changes to winrt_activation_handler don't apply to it.
+    template <typename Interface = Windows::Foundation::IActivationFactory>
+    impl::com_ref<Interface> get_cached_activation_factory(param::hstring const& name)
+    {
+        void* result{};
+        check_hresult(impl::get_factory_cache().get<Interface>(name, &result));
+        return { result, take_ownership_from_abi };
+    }
+
     inline void clear_factory_cache() noexcept
     {
         impl::get_factory_cache().clear();
     }
 
+    // Counts the requests made through get_cached_activation_factory and preload_factory_cache. Classes activated by
+    // type are cached separately and aren't counted, so that their warm path stays a single load.
+    inline factory_cache_statistics get_factory_cache_statistics() noexcept
+    {
+        return impl::get_factory_cache().statistics();
+    }
+
     template <typename Interface>
     auto try_create_instance(guid const& clsid, uint32_t context = 0x1 /*CLSCTX_INPROC_SERVER*/, void* outer = nullptr)
     {
@@ -546,6 +761,32 @@ WINRT_EXPORT namespace winrt
             }
         };
     }
+
+    // Activates the factories of the named classes ahead of their first use, so that the first call to
+    // get_cached_activation_factory for each is served from the cache. Returns the number of factories that could be
+    // cached.
+    inline uint32_t preload_factory_cache(array_view<hstring const> names)
+    {
+        uint32_t count{};
+
+        for (auto&& name : names)
+        {
+            void* result{};
+            hresult const hr = impl::get_factory_cache().get<Windows::Foundation::IActivationFactory>(name, &result);
+
+            if (hr < 0)
+            {
+                // Ensure that the IRestrictedErrorInfo is not left on the thread.
+                hresult_error const exception{ hr, take_ownership_from_abi };
+                continue;
+            }
+
+            impl::com_ref<Windows::Foundation::IActivationFactory> const factory{ result, take_ownership_from_abi };
+            count += factory.try_as<impl::IAgileObject>() ? 1 : 0;
+        }
+
+        return count;
+    }
 }
 
 namespace winrt::impl
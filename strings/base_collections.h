@@ -135,4 +135,17 @@ namespace winrt::impl
             return last;
         }
     };
+
+    // A range over non-random-access iterators along with its length, measured once by the owner so that Size and
+    // bounds checks don't have to walk the range again.
+    template <typename T>
+    struct sized_range_container : range_container<T>
+    {
+        uint32_t const count;
+
+        uint32_t size() const noexcept
+        {
+            return count;
+        }
+    };
 }
@@ -2,6 +2,9 @@ namespace winrt::impl
 {
     struct nop_lock_guard {};
 
+    // Returned by retain_container when the policy's iterators don't need to keep anything alive.
+    struct nop_container_reference {};
+
     struct single_threaded_collection_base
     {
         [[nodiscard]] auto acquire_exclusive() const
@@ -32,9 +35,243 @@ namespace winrt::impl
         mutable slim_mutex m_mutex;
     };
 
+    // A copy-on-write threading policy for read-mostly collections shared between many threads. Readers never take a
+    // lock. They register with reader_epochs and read the snapshot that was current when they started. Writers
+    // are serialized. The first change a writer makes copies the current snapshot. The modified copy is published when
+    // the writer's guard is released. The old snapshot is then freed once every reader that could still see it has
+    // finished and no iterator still refers to it. A writer that fails with an exception publishes nothing, so changes
+    // are all-or-nothing.
+    //
+    // Iterators hold a reference to the snapshot they were created on, since a writer bumps the collection's version
+    // before it publishes. An iterator created in between records the new version yet refers to the old snapshot.
+    //
+    // The container lives in the policy rather than in the collection, since which copy get_container returns depends
+    // on the guard held by the calling thread.
+    template <typename Container>
+    struct snapshot_collection_base
+    {
+        snapshot_collection_base(snapshot_collection_base const&) = delete;
+        snapshot_collection_base& operator=(snapshot_collection_base const&) = delete;
+
+        explicit snapshot_collection_base(Container&& values) : m_current(new snapshot_type(std::move(values)))
+        {
+        }
+
+        ~snapshot_collection_base() noexcept
+        {
+            release(m_current.load(std::memory_order_relaxed));
+        }
+
+        [[nodiscard]] auto acquire_exclusive() const
+        {
+            return exclusive_guard{ *this };
+        }
+
+        [[nodiscard]] auto acquire_shared() const
+        {
+            return shared_guard{ *this };
+        }
+
+        Container& get_container() noexcept
+        {
+            if (auto pin = find_pin())
+            {
+                if (pin->exclusive && !pin->pending)
+                {
+                    pin->pending = new snapshot_type(pin->snapshot->container);
+                    pin->snapshot = pin->pending;
+                }
+
+                // Readers are handed the shared snapshot, which the collection's read operations never modify.
+                return pin->snapshot->container;
+            }
+
+            return m_current.load()->container;
+        }
+
+        Container const& get_container() const noexcept
+        {
+            if (auto pin = find_pin())
+            {
+                return pin->snapshot->container;
+            }
+
+            return m_current.load()->container;
+        }
+
+    private:
+
+        struct snapshot_type
+        {
+            explicit snapshot_type(Container&& values) : container(std::move(values))
+            {
+            }
+
+            explicit snapshot_type(Container const& values) : container(values)
+            {
+            }
+
+            Container container;
+            std::atomic<uint32_t> references{ 1 };
+        };
+
+        static void release(snapshot_type* snapshot) noexcept
+        {
+            if (snapshot->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                delete snapshot;
+            }
+        }
+
+    public:
+
+        struct container_reference
+        {
+            explicit container_reference(snapshot_type* snapshot) noexcept : m_snapshot(snapshot)
+            {
+                m_snapshot->references.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            container_reference(container_reference const&) = delete;
+
+            ~container_reference() noexcept
+            {
+                release(m_snapshot);
+            }
+
+        private:
+
+            snapshot_type* const m_snapshot;
+        };
+
+        // Keeps the snapshot returned by get_container alive for as long as the result, even after a writer has
+        // replaced it. Must be called while holding a guard, which keeps the snapshot alive until then.
+        [[nodiscard]] auto retain_container() const noexcept
+        {
+            auto pin = find_pin();
+            WINRT_ASSERT(pin);
+            return container_reference{ pin ? pin->snapshot : m_current.load() };
+        }
+
+    private:
+
+        // Records the snapshot a guard on the current thread is using. Pins nest when one collection is used while
+        // another's guard is held, for example by an element comparison.
+        struct pin_type
+        {
+            snapshot_collection_base const* owner{};
+            snapshot_type* snapshot{};
+            snapshot_type* pending{};
+            bool exclusive{};
+            pin_type* previous{};
+        };
+
+        inline static thread_local pin_type* t_pins{};
+
+        pin_type* find_pin() const noexcept
+        {
+            for (auto pin = t_pins; pin; pin = pin->previous)
+            {
+                if (pin->owner == this)
+                {
+                    return pin;
+                }
+            }
+
+            return nullptr;
+        }
+
+        struct shared_guard
+        {
+            explicit shared_guard(snapshot_collection_base const& owner) noexcept :
+                m_reader(owner.m_readers)
+            {
+                m_pin.owner = &owner;
+                m_pin.snapshot = owner.m_current.load();
+                m_pin.previous = std::exchange(t_pins, &m_pin);
+            }
+
+            shared_guard(shared_guard const&) = delete;
+
+            ~shared_guard() noexcept
+            {
+                t_pins = m_pin.previous;
+            }
+
+        private:
+
+            reader_epochs::reader m_reader;
+            pin_type m_pin;
+        };
+
+        struct exclusive_guard
+        {
+            explicit exclusive_guard(snapshot_collection_base const& owner) noexcept :
+                m_lock(owner.m_mutex),
+                m_exceptions(std::uncaught_exceptions())
+            {
+                m_pin.owner = &owner;
+                m_pin.snapshot = owner.m_current.load();
+                m_pin.exclusive = true;
+                m_pin.previous = std::exchange(t_pins, &m_pin);
+            }
+
+            exclusive_guard(exclusive_guard const&) = delete;
+
+            ~exclusive_guard() noexcept
+            {
+                t_pins = m_pin.previous;
+
+                if (!m_pin.pending)
+                {
+                    return;
+                }
+
+                if (std::uncaught_exceptions() > m_exceptions)
+                {
+                    release(m_pin.pending);
+                    return;
+                }
+
+                m_pin.owner->publish(m_pin.pending);
+            }
+
+        private:
+
+            slim_lock_guard m_lock;
+            int const m_exceptions;
+            pin_type m_pin;
+        };
+
+        void publish(snapshot_type* snapshot) const noexcept
+        {
+            snapshot_type* previous = m_current.exchange(snapshot);
+            m_readers.synchronize();
+            release(previous);
+        }
+
+        mutable std::atomic<snapshot_type*> m_current;
+        mutable reader_epochs m_readers;
+        mutable slim_mutex m_mutex;
+    };
+
     template <typename D>
     using container_type_t = std::decay_t<decltype(std::declval<D>().get_container())>;
 
+    template <typename Container, typename = void>
+    struct has_container_size : std::false_type {};
+
+    template <typename Container>
+    struct has_container_size<Container, std::void_t<decltype(std::declval<Container const&>().size())>> : std::true_type {};
+
+    // Iterators over contiguous storage, whose elements can be copied with memcpy when they are trivially copyable.
+    template <typename Iterator>
+#ifdef __cpp_lib_concepts
+    inline constexpr bool is_contiguous_iterator_v = std::contiguous_iterator<Iterator>;
+#else
+    inline constexpr bool is_contiguous_iterator_v = std::is_pointer_v<Iterator>;
+#endif
+
     template <typename D, typename = void>
     struct removed_values
     {
@@ -105,6 +342,12 @@ WINRT_EXPORT namespace winrt
             return static_cast<D const&>(*this).acquire_exclusive();
         }
 
+        auto retain_container() const noexcept
+        {
+            // Only needed by policies that may free the container while an iterator still refers to it
+            return impl::nop_container_reference{};
+        }
+
         auto First()
         {
             // NOTE: iterator's constructor requires shared access
@@ -119,7 +362,17 @@ WINRT_EXPORT namespace winrt
         {
             if constexpr (std::is_same_v<T, std::decay_t<decltype(*std::declval<D const>().get_container().begin())>> && !impl::is_key_value_pair<T>::value)
             {
-                std::copy_n(first, count, result);
+                if constexpr (std::is_trivially_copyable_v<T> && impl::is_contiguous_iterator_v<InputIt> && impl::is_contiguous_iterator_v<OutputIt>)
+                {
+                    if (count > 0)
+                    {
+                        std::memcpy(std::addressof(*result), std::addressof(*first), static_cast<size_t>(count) * sizeof(T));
+                    }
+                }
+                else
+                {
+                    std::copy_n(first, count, result);
+                }
             }
             else
             {
@@ -153,6 +406,7 @@ WINRT_EXPORT namespace winrt
 
             explicit iterator(D* const owner) noexcept :
                 Version::iterator_type(*owner),
+                m_container(owner->retain_container()),
                 m_current(owner->get_container().begin()),
                 m_end(owner->get_container().end())
             {
@@ -161,6 +415,7 @@ WINRT_EXPORT namespace winrt
 
             T Current() const
             {
+                [[maybe_unused]] auto position = acquire_position();
                 [[maybe_unused]] auto guard = m_owner->acquire_shared();
                 this->check_version(*m_owner);
 
@@ -174,6 +429,7 @@ WINRT_EXPORT namespace winrt
 
             bool HasCurrent() const
             {
+                [[maybe_unused]] auto position = acquire_position();
                 [[maybe_unused]] auto guard = m_owner->acquire_shared();
                 this->check_version(*m_owner);
                 return m_current != m_end;
@@ -181,7 +437,8 @@ WINRT_EXPORT namespace winrt
 
             bool MoveNext()
             {
-                [[maybe_unused]] auto guard = m_owner->acquire_exclusive();
+                [[maybe_unused]] auto position = acquire_position();
+                [[maybe_unused]] auto guard = acquire_move();
                 this->check_version(*m_owner);
                 if (m_current != m_end)
                 {
@@ -193,13 +450,44 @@ WINRT_EXPORT namespace winrt
 
             uint32_t GetMany(array_view<T> values)
             {
-                [[maybe_unused]] auto guard = m_owner->acquire_exclusive();
+                [[maybe_unused]] auto position = acquire_position();
+                [[maybe_unused]] auto guard = acquire_move();
                 this->check_version(*m_owner);
                 return GetMany(values, typename std::iterator_traits<iterator_type>::iterator_category());
             }
 
         private:
 
+            // Iterators move under exclusive access, except with the snapshot policy, whose exclusive access is meant
+            // for writers and would serialize every iterating reader. Those move under shared access instead and
+            // serialize changes to their own position. The position lock is taken first, since a thread waiting for
+            // shared access while holding it could otherwise block one that holds shared access and wants it.
+            static constexpr bool is_snapshot = !std::is_same_v<decltype(std::declval<D const&>().retain_container()), impl::nop_container_reference>;
+
+            auto acquire_position() const
+            {
+                if constexpr (is_snapshot)
+                {
+                    return slim_lock_guard{ m_position_lock };
+                }
+                else
+                {
+                    return impl::nop_lock_guard{};
+                }
+            }
+
+            auto acquire_move() const
+            {
+                if constexpr (is_snapshot)
+                {
+                    return m_owner->acquire_shared();
+                }
+                else
+                {
+                    return m_owner->acquire_exclusive();
+                }
+            }
+
             T current_value_withlock() const
             {
                 WINRT_ASSERT(m_current != m_end);
@@ -238,8 +526,10 @@ WINRT_EXPORT namespace winrt
             using iterator_type = decltype(std::declval<D>().get_container().begin());
 
             com_ptr<D> m_owner;
+            decltype(std::declval<D const&>().retain_container()) const m_container;
             iterator_type m_current;
             iterator_type const m_end;
+            mutable std::conditional_t<is_snapshot, slim_mutex, impl::nop_lock_guard> m_position_lock;
         };
     };
 
@@ -266,25 +556,33 @@ WINRT_EXPORT namespace winrt
         bool IndexOf(T const& value, uint32_t& index) const noexcept
         {
             [[maybe_unused]] auto guard = static_cast<D const&>(*this).acquire_shared();
-            auto first = std::find_if(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end(), [&](auto&& match)
+            auto&& container = static_cast<D const&>(*this).get_container();
+            auto const end = container.end();
+            index = 0;
+
+            for (auto first = container.begin(); first != end; ++first, ++index)
             {
-                return value == static_cast<D const&>(*this).unwrap_value(match);
-            });
+                if (value == static_cast<D const&>(*this).unwrap_value(*first))
+                {
+                    return true;
+                }
+            }
 
-            index = static_cast<uint32_t>(first - static_cast<D const&>(*this).get_container().begin());
-            return index < container_size();
+            return false;
         }
 
         uint32_t GetMany(uint32_t const startIndex, array_view<T> values) const
         {
             [[maybe_unused]] auto guard = static_cast<D const&>(*this).acquire_shared();
-            if (startIndex >= container_size())
+            uint32_t const size = container_size();
+
+            if (startIndex >= size)
             {
                 return 0;
             }
 
-            uint32_t const actual = (std::min)(container_size() - startIndex, values.size());
-            this->copy_n(static_cast<D const&>(*this).get_container().begin() + startIndex, actual, values.begin());
+            uint32_t const actual = (std::min)(size - startIndex, values.size());
+            this->copy_n(std::next(static_cast<D const&>(*this).get_container().begin(), startIndex), actual, values.begin());
             return actual;
         }
 
@@ -292,7 +590,18 @@ WINRT_EXPORT namespace winrt
 
         uint32_t container_size() const noexcept
         {
-            return static_cast<uint32_t>(std::distance(static_cast<D const&>(*this).get_container().begin(), static_cast<D const&>(*this).get_container().end()));
+            // Prefer the container's own size, which is constant time for node-based containers such as std::list
+            // where measuring the distance between its iterators would have to walk every element.
+            auto&& container = static_cast<D const&>(*this).get_container();
+
+            if constexpr (impl::has_container_size<std::decay_t<decltype(container)>>::value)
+            {
+                return static_cast<uint32_t>(container.size());
+            }
+            else
+            {
+                return static_cast<uint32_t>(std::distance(container.begin(), container.end()));
+            }
         }
     };
 
@@ -33,13 +33,13 @@ namespace winrt::impl
             check_scope();
         }
 
-        scoped_input_vector_view(InputIt first, InputIt last) : m_begin(first), m_end(last)
+        scoped_input_vector_view(InputIt first, InputIt last) : m_begin(first), m_end(last), m_size(static_cast<uint32_t>(std::distance(first, last)))
         {
         }
 
         auto get_container() const noexcept
         {
-            return range_container<InputIt>{ m_begin, m_end };
+            return sized_range_container<InputIt>{ { m_begin, m_end }, m_size };
         }
 
 #if defined(_DEBUG) && !defined(WINRT_NO_MAKE_DETECTION)
@@ -52,6 +52,7 @@ namespace winrt::impl
 
         InputIt const m_begin;
         InputIt const m_end;
+        uint32_t const m_size;
     };
 
     template <typename T, typename InputIt>
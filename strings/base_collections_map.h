@@ -39,6 +39,24 @@ namespace winrt::impl
 
     template <typename K, typename V, typename Container>
     using multi_threaded_observable_map = observable_map_impl<K, V, Container, multi_threaded_collection_base>;
+
+    template <typename K, typename V, typename Container>
+    struct snapshot_map :
+        implements<snapshot_map<K, V, Container>, wfc::IMap<K, V>, wfc::IMapView<K, V>, wfc::IIterable<wfc::IKeyValuePair<K, V>>>,
+        map_base<snapshot_map<K, V, Container>, K, V>,
+        snapshot_collection_base<Container>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit snapshot_map(Container&& values) : snapshot_collection_base<Container>(std::move(values))
+        {
+        }
+
+        using snapshot_collection_base<Container>::get_container;
+        using snapshot_collection_base<Container>::acquire_shared;
+        using snapshot_collection_base<Container>::acquire_exclusive;
+        using snapshot_collection_base<Container>::retain_container;
+    };
 }
 
 WINRT_EXPORT namespace winrt
@@ -114,6 +132,24 @@ WINRT_EXPORT namespace winrt
     {
         return make<impl::multi_threaded_observable_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
     }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> snapshot_map()
+    {
+        return make<impl::snapshot_map<K, V, std::map<K, V, Compare, Allocator>>>(std::map<K, V, Compare, Allocator>{});
+    }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> snapshot_map(std::map<K, V, Compare, Allocator>&& values)
+    {
+        return make<impl::snapshot_map<K, V, std::map<K, V, Compare, Allocator>>>(std::move(values));
+    }
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Windows::Foundation::Collections::IMap<K, V> snapshot_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator>&& values)
+    {
+        return make<impl::snapshot_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
+    }
 }
 
 namespace std
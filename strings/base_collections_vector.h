@@ -295,6 +295,24 @@ namespace winrt::impl
 
     template <typename T, typename Container>
     using multi_threaded_convertible_observable_vector = convertible_observable_vector<T, Container, multi_threaded_collection_base>;
+
+    template <typename T, typename Container>
+    struct snapshot_vector :
+        implements<snapshot_vector<T, Container>, wfc::IVector<T>, wfc::IVectorView<T>, wfc::IIterable<T>>,
+        vector_base<snapshot_vector<T, Container>, T>,
+        snapshot_collection_base<Container>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        explicit snapshot_vector(Container&& values) : snapshot_collection_base<Container>(std::move(values))
+        {
+        }
+
+        using snapshot_collection_base<Container>::get_container;
+        using snapshot_collection_base<Container>::acquire_shared;
+        using snapshot_collection_base<Container>::acquire_exclusive;
+        using snapshot_collection_base<Container>::retain_container;
+    };
 }
 
 WINRT_EXPORT namespace winrt
@@ -336,4 +354,10 @@ WINRT_EXPORT namespace winrt
             return make<impl::multi_threaded_convertible_observable_vector<T, std::vector<T, Allocator>>>(std::move(values));
         }
     }
+
+    template <typename T, typename Allocator = std::allocator<T>>
+    Windows::Foundation::Collections::IVector<T> snapshot_vector(std::vector<T, Allocator>&& values = {})
+    {
+        return make<impl::snapshot_vector<T, std::vector<T, Allocator>>>(std::move(values));
+    }
 }
@@ -49,21 +49,48 @@ namespace winrt::impl
     template <typename Async>
     auto wait_for_completed(Async const& async, uint32_t const timeout)
     {
+        // The waiting thread blocks on a condition variable in the delegate itself, so waiting does not create a
+        // kernel object. An async object that has already completed calls the delegate before Completed returns, so
+        // the wait is then satisfied without blocking at all.
         struct shared_type
         {
-            handle event{ check_pointer(WINRT_IMPL_CreateEventW(nullptr, true, false, nullptr)) };
+            slim_mutex lock;
+            slim_condition_variable cv;
             Windows::Foundation::AsyncStatus status{ Windows::Foundation::AsyncStatus::Started };
 
+            shared_type() noexcept = default;
+
+            // Only moved into the delegate, before anything can wait on it.
+            shared_type(shared_type&&) noexcept
+            {
+            }
+
             void operator()(Async const&, Windows::Foundation::AsyncStatus operation_status) noexcept
             {
+                slim_lock_guard const guard(lock);
                 status = operation_status;
-                WINRT_VERIFY(WINRT_IMPL_SetEvent(event.get()));
+                cv.notify_all();
+            }
+
+            bool completed() const noexcept
+            {
+                return status != Windows::Foundation::AsyncStatus::Started;
             }
         };
 
         auto [delegate, shared] = make_delegate_with_shared_state<async_completed_handler_t<Async>>(shared_type{});
         async.Completed(delegate);
-        WINRT_IMPL_WaitForSingleObject(shared->event.get(), timeout);
+        slim_lock_guard const guard(shared->lock);
+
+        if (timeout == 0xFFFFFFFF) // INFINITE
+        {
+            shared->cv.wait(shared->lock, [shared = shared] { return shared->completed(); });
+        }
+        else
+        {
+            shared->cv.wait_for(shared->lock, std::chrono::milliseconds(timeout), [shared = shared] { return shared->completed(); });
+        }
+
         return shared->status;
     }
 
@@ -150,6 +177,19 @@ namespace winrt::impl
     };
 
 #ifdef WINRT_IMPL_COROUTINES
+    template <typename Async>
+    fire_and_forget cancel_asynchronously(Async async)
+    {
+        co_await winrt::resume_background();
+        try
+        {
+            async.Cancel();
+        }
+        catch (hresult_error const&)
+        {
+        }
+    }
+
     template <typename Async, bool preserve_context = true>
     struct await_adapter : cancellable_awaiter<await_adapter<Async, preserve_context>>
     {
@@ -199,18 +239,341 @@ namespace winrt::impl
             async.Completed(disconnect_aware_handler<preserve_context, await_adapter>(this, handle));
             return suspending.exchange(false, std::memory_order_acquire);
         }
+    };
+
+    template <typename T>
+    struct is_async : std::false_type {};
+
+    template <>
+    struct is_async<Windows::Foundation::IAsyncAction> : std::true_type {};
+
+    template <typename TProgress>
+    struct is_async<Windows::Foundation::IAsyncActionWithProgress<TProgress>> : std::true_type {};
+
+    template <typename TResult>
+    struct is_async<Windows::Foundation::IAsyncOperation<TResult>> : std::true_type {};
+
+    template <typename TResult, typename TProgress>
+    struct is_async<Windows::Foundation::IAsyncOperationWithProgress<TResult, TProgress>> : std::true_type {};
+
+    template <typename T>
+    inline constexpr bool is_async_v = is_async<T>::value;
+
+    template <typename Range, typename = void>
+    struct range_element
+    {
+        using type = void;
+    };
+
+    template <typename Range>
+    struct range_element<Range, std::void_t<decltype(std::begin(std::declval<Range const&>()))>>
+    {
+        using type = std::decay_t<decltype(*std::begin(std::declval<Range const&>()))>;
+    };
+
+    // Counts down the async objects awaited by when_all. Each one's Completed handler counts down, and the handler
+    // that brings the count to zero resumes the awaiting coroutine, so the coroutine suspends and resumes only once
+    // however many async objects it waits for. The count starts one higher than the number of async objects so that
+    // handlers that run while the rest are still being registered cannot resume the coroutine before await_suspend
+    // has returned.
+    struct when_all_countdown : resume_apartment_context
+    {
+        explicit when_all_countdown(uint32_t const count) noexcept : m_remaining(count + 1)
+        {
+        }
+
+        // Returns true if this brought the count to zero.
+        bool release(uint32_t const count = 1) noexcept
+        {
+            return m_remaining.fetch_sub(count, std::memory_order_acq_rel) == count;
+        }
+
+        void complete()
+        {
+            if (release() && !m_abandoned.load(std::memory_order_relaxed))
+            {
+                if (!resume_apartment(*this, m_handle, &m_failure))
+                {
+                    m_handle.resume();
+                }
+            }
+        }
+
+        std::atomic<uint32_t> m_remaining;
+        std::atomic<bool> m_abandoned{};
+        coroutine_handle<> m_handle;
+        int32_t m_failure{};
+    };
+
+    // The Completed handler registered by when_all. Like disconnect_aware_handler, it also counts down if it is
+    // destroyed without being called, which happens when an out-of-process server dies before completing. The
+    // coroutine then resumes and the failure is reported when the results are collected.
+    struct when_all_handler
+    {
+        explicit when_all_handler(std::shared_ptr<when_all_countdown> const& countdown) noexcept : m_countdown(countdown)
+        {
+        }
+
+        when_all_handler(when_all_handler&& other) = default;
+
+        ~when_all_handler()
+        {
+            if (m_countdown) m_countdown->complete();
+        }
+
+        template <typename Async>
+        void operator()(Async&&, Windows::Foundation::AsyncStatus)
+        {
+            std::exchange(m_countdown, nullptr)->complete();
+        }
+
+    private:
+
+        std::shared_ptr<when_all_countdown> m_countdown;
+    };
+
+    template <typename Derived>
+    struct when_all_awaiter_base : cancellable_awaiter<Derived>
+    {
+        void enable_cancellation(cancellable_promise* promise)
+        {
+            promise->set_canceller([](void* parameter)
+            {
+                static_cast<Derived*>(parameter)->for_each([](auto const& async)
+                {
+                    cancel_asynchronously(async);
+                });
+            }, static_cast<Derived*>(this));
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
 
-        static fire_and_forget cancel_asynchronously(Async async)
+        template <typename T>
+        bool await_suspend(coroutine_handle<T> handle)
         {
-            co_await winrt::resume_background();
+            this->set_cancellable_promise_from_handle(handle);
+            auto const count = static_cast<Derived*>(this)->size();
+            m_countdown = std::make_shared<when_all_countdown>(count);
+            m_countdown->m_handle = handle;
+            uint32_t registered{};
+
             try
             {
-                async.Cancel();
+                static_cast<Derived*>(this)->for_each([&](auto const& async)
+                {
+                    async.Completed(when_all_handler{ m_countdown });
+                    ++registered;
+                });
             }
-            catch (hresult_error const&)
+            catch (...)
             {
+                // The coroutine resumes with the exception, so handlers that are already registered must not resume
+                // it again. The handler that failed to register has already counted down as it was destroyed.
+                m_countdown->m_abandoned.store(true, std::memory_order_relaxed);
+                m_countdown->release(count - registered);
+                throw;
             }
+
+            return !m_countdown->release();
         }
+
+    protected:
+
+        // Rethrows the first failure among the async objects, in the order they were given.
+        template <typename Async>
+        static auto get_results(Async const& async)
+        {
+            check_status_canceled(async.Status());
+            return async.GetResults();
+        }
+
+        void check_failure() const
+        {
+            check_hresult(m_countdown->m_failure);
+        }
+
+    private:
+
+        std::shared_ptr<when_all_countdown> m_countdown;
+    };
+
+    template <typename... Async>
+    struct when_all_awaiter : when_all_awaiter_base<when_all_awaiter<Async...>>
+    {
+        explicit when_all_awaiter(Async const&... async) : m_async(async...)
+        {
+        }
+
+        uint32_t size() const noexcept
+        {
+            return sizeof...(Async);
+        }
+
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            std::apply([&](auto const&... async) { (f(async), ...); }, m_async);
+        }
+
+        void await_resume() const
+        {
+            this->check_failure();
+            std::apply([](auto const&... async) { (void(this_type::get_results(async)), ...); }, m_async);
+        }
+
+    private:
+
+        using this_type = when_all_awaiter;
+        std::tuple<Async...> m_async;
+    };
+
+    template <typename Async>
+    struct when_all_range_awaiter : when_all_awaiter_base<when_all_range_awaiter<Async>>
+    {
+        template <typename Range>
+        explicit when_all_range_awaiter(Range const& range) : m_async(std::begin(range), std::end(range))
+        {
+        }
+
+        uint32_t size() const noexcept
+        {
+            return static_cast<uint32_t>(m_async.size());
+        }
+
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            for (auto&& async : m_async)
+            {
+                f(async);
+            }
+        }
+
+        auto await_resume() const
+        {
+            this->check_failure();
+            using result_type = decltype(std::declval<Async const&>().GetResults());
+
+            if constexpr (std::is_void_v<result_type>)
+            {
+                for (auto&& async : m_async)
+                {
+                    this->get_results(async);
+                }
+            }
+            else
+            {
+                std::vector<result_type> results;
+                results.reserve(m_async.size());
+
+                for (auto&& async : m_async)
+                {
+                    results.push_back(this->get_results(async));
+                }
+
+                return results;
+            }
+        }
+
+    private:
+
+        std::vector<Async> m_async;
+    };
+
+    // The Completed handler registered by when_any. The first async object to complete, or the cancellation of the
+    // when_any coroutine, resumes the coroutine on the thread pool rather than in the handler of the async object that
+    // completed. The count starts at two so that the coroutine is resumed only once both that has happened and the
+    // coroutine has suspended, whichever comes last. If the coroutine suspends last, it continues on its own thread.
+    template <typename T>
+    struct when_any_state
+    {
+        Windows::Foundation::AsyncStatus status{ Windows::Foundation::AsyncStatus::Started };
+        T result;
+        std::atomic<bool> claimed{};
+        std::atomic<uint32_t> remaining{ 2 };
+        coroutine_handle<> handle;
+
+        when_any_state() noexcept = default;
+
+        // Only moved into the delegate, before any async object can call it.
+        when_any_state(when_any_state&&) noexcept
+        {
+        }
+
+        void operator()(T const& sender, Windows::Foundation::AsyncStatus const operation_status) noexcept
+        {
+            if (!claimed.exchange(true, std::memory_order_relaxed))
+            {
+                result = sender;
+                status = operation_status;
+                complete();
+            }
+        }
+
+        void cancel() noexcept
+        {
+            if (!claimed.exchange(true, std::memory_order_relaxed))
+            {
+                status = Windows::Foundation::AsyncStatus::Canceled;
+                complete();
+            }
+        }
+
+        // Returns true if this brought the count to zero.
+        bool release() noexcept
+        {
+            return remaining.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        }
+
+    private:
+
+        void complete() noexcept
+        {
+            if (release())
+            {
+                resume_background_or_inline(handle);
+            }
+        }
+    };
+
+    template <typename T>
+    struct when_any_awaiter : cancellable_awaiter<when_any_awaiter<T>>
+    {
+        explicit when_any_awaiter(when_any_state<T>* shared) noexcept : m_shared(shared)
+        {
+        }
+
+        void enable_cancellation(cancellable_promise* promise)
+        {
+            promise->set_canceller([](void* parameter)
+            {
+                static_cast<when_any_state<T>*>(parameter)->cancel();
+            }, m_shared);
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template <typename Promise>
+        bool await_suspend(coroutine_handle<Promise> handle)
+        {
+            m_shared->handle = handle;
+            this->set_cancellable_promise_from_handle(handle);
+            return !m_shared->release();
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+    private:
+
+        when_any_state<T>* m_shared;
     };
 #endif
 
@@ -395,11 +758,95 @@ namespace winrt::impl
         Promise* m_promise;
     };
 
+    // When winrt_coroutine_frame_pool_enabled is set, the frames of coroutines returning IAsyncAction, IAsyncOperation
+    // and their progress variants are allocated in a few fixed size classes, and a destroyed frame is kept in a
+    // per-thread cache for reuse by the next coroutine of the same size class started on that thread. A coroutine
+    // often completes on another thread than the one it started on, in which case its frame joins that thread's cache.
+    // Each frame is preceded by a header recording its size class, so that frames allocated while the pool was
+    // disabled are never cached. The header is present whether or not the pool is enabled, and adds
+    // __STDCPP_DEFAULT_NEW_ALIGNMENT__ bytes (16 on 64-bit targets) to every frame.
+    struct coroutine_frame_pool
+    {
+        using cache = size_class_cache<coroutine_frame_pool, 6, 256, 32>;
+
+        static void* allocate(size_t const size)
+        {
+            size_t const bytes = size + sizeof(header);
+            uint32_t index = cache::class_count;
+            void* block;
+
+            if (winrt_coroutine_frame_pool_enabled)
+            {
+                index = cache::class_index(bytes);
+            }
+
+            if (index < cache::class_count)
+            {
+                block = cache::allocate(index);
+            }
+            else
+            {
+                block = ::operator new(bytes);
+            }
+
+            auto frame = static_cast<header*>(block);
+            frame->index = index;
+            return frame + 1;
+        }
+
+        static void deallocate(void* const frame) noexcept
+        {
+            auto block = static_cast<header*>(frame) - 1;
+
+            if (block->index < cache::class_count && winrt_coroutine_frame_pool_enabled)
+            {
+                cache::deallocate(block, block->index);
+            }
+            else
+            {
+                ::operator delete(block);
+            }
+        }
+
+    private:
+
+        struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) header
+        {
+            uint32_t index;
+        };
+    };
+
+#if defined(_MSC_VER)
+#define WINRT_IMPL_RETURNADDRESS() _ReturnAddress()
+#elif defined(__GNUC__)
+#define WINRT_IMPL_RETURNADDRESS() __builtin_extract_return_addr(__builtin_return_address(0))
+#else
+#define WINRT_IMPL_RETURNADDRESS() nullptr
+#endif
+
     template <typename Derived, typename AsyncInterface, typename TProgress = void>
     struct promise_base : implements<Derived, AsyncInterface, Windows::Foundation::IAsyncInfo>, cancellable_promise
     {
         using AsyncStatus = Windows::Foundation::AsyncStatus;
 
+        // The frame is allocated by the coroutine itself, so the return address identifies the coroutine to the
+        // winrt_coroutine_frame_handler. This keeps operator new out of line, which costs every coroutine a call even
+        // when neither the handler nor the pool is in use.
+        WINRT_IMPL_NOINLINE static void* operator new(size_t const size)
+        {
+            if (winrt_coroutine_frame_handler)
+            {
+                winrt_coroutine_frame_handler(WINRT_IMPL_RETURNADDRESS(), static_cast<uint32_t>(size));
+            }
+
+            return coroutine_frame_pool::allocate(size);
+        }
+
+        static void operator delete(void* const frame) noexcept
+        {
+            coroutine_frame_pool::deallocate(frame);
+        }
+
         unsigned long __stdcall Release() noexcept
         {
             uint32_t const remaining = this->subtract_reference();
@@ -687,6 +1134,8 @@ namespace winrt::impl
     };
 }
 
+#undef WINRT_IMPL_RETURNADDRESS
+
 #ifdef __cpp_lib_coroutine
 namespace std
 #else
@@ -830,36 +1279,35 @@ WINRT_EXPORT namespace winrt
     template <typename... T>
     Windows::Foundation::IAsyncAction when_all(T... async)
     {
-        (void(co_await async), ...);
+        if constexpr (sizeof...(T) > 0 && (impl::is_async_v<T> && ...))
+        {
+            co_await impl::when_all_awaiter<T...>(async...);
+        }
+        else
+        {
+            (void(co_await async), ...);
+        }
+
         co_return;
     }
 
+    // Awaits every async object in the range, and produces a std::vector of their results in the same order unless
+    // they are actions.
+    template <typename Range, std::enable_if_t<impl::is_async_v<typename impl::range_element<Range>::type>, int> = 0>
+    [[nodiscard]] auto when_all(Range const& async)
+    {
+        return impl::when_all_range_awaiter<typename impl::range_element<Range>::type>(async);
+    }
+
     template <typename T, typename... Rest>
     T when_any(T const& first, Rest const& ... rest)
     {
         static_assert(impl::has_category_v<T>, "T must be WinRT async type such as IAsyncAction or IAsyncOperation.");
         static_assert((std::is_same_v<T, Rest> && ...), "All when_any parameters must be the same type.");
 
-        struct shared_type
-        {
-            handle event{ check_pointer(WINRT_IMPL_CreateEventW(nullptr, true, false, nullptr)) };
-            Windows::Foundation::AsyncStatus status{ Windows::Foundation::AsyncStatus::Started };
-            T result;
-
-            void operator()(T const& sender, Windows::Foundation::AsyncStatus operation_status) noexcept
-            {
-                auto sender_abi = *(impl::unknown_abi**)&sender;
-
-                if (nullptr == _InterlockedCompareExchangePointer(reinterpret_cast<void**>(&result), sender_abi, nullptr))
-                {
-                    sender_abi->AddRef();
-                    status = operation_status;
-                    WINRT_VERIFY(WINRT_IMPL_SetEvent(event.get()));
-                }
-            }
-        };
-
-        auto [delegate, shared] = impl::make_delegate_with_shared_state<impl::async_completed_handler_t<T>>(shared_type{});
+        auto cancellation = co_await get_cancellation_token();
+        cancellation.enable_propagation();
+        auto [delegate, shared] = impl::make_delegate_with_shared_state<impl::async_completed_handler_t<T>>(impl::when_any_state<T>{});
 
         auto completed = [delegate = std::move(delegate)](T const& async)
         {
@@ -868,7 +1316,7 @@ WINRT_EXPORT namespace winrt
 
         completed(first);
         (completed(rest), ...);
-        co_await resume_on_signal(shared->event.get());
+        co_await impl::when_any_awaiter<T>{ shared };
         impl::check_status_canceled(shared->status);
         co_return shared->result.GetResults();
     }
@@ -3,7 +3,11 @@ namespace winrt::impl
 {
     inline auto submit_threadpool_callback(void(__stdcall* callback)(void*, void* context), void* context)
     {
-        if (!WINRT_IMPL_TrySubmitThreadpoolCallback(callback, context, nullptr))
+        if (winrt_resume_background_handler)
+        {
+            check_hresult(winrt_resume_background_handler(callback, context));
+        }
+        else if (!WINRT_IMPL_TrySubmitThreadpoolCallback(callback, context, nullptr))
         {
             throw_last_error();
         }
@@ -19,6 +23,19 @@ namespace winrt::impl
         submit_threadpool_callback(resume_background_callback, handle.address());
     }
 
+    // For callers that cannot fail, the coroutine resumes on the calling thread if the thread pool refuses it.
+    inline void resume_background_or_inline(coroutine_handle<> handle) noexcept
+    {
+        try
+        {
+            resume_background(handle);
+        }
+        catch (...)
+        {
+            handle();
+        }
+    }
+
     inline std::pair<int32_t, int32_t> get_apartment_type() noexcept
     {
         int32_t aptType;
@@ -273,11 +290,7 @@ WINRT_EXPORT namespace winrt
             void await_suspend(impl::coroutine_handle<> resume)
             {
                 m_resume = resume;
-
-                if (!WINRT_IMPL_TrySubmitThreadpoolCallback(callback, this, nullptr))
-                {
-                    throw_last_error();
-                }
+                impl::submit_threadpool_callback(callback, this);
             }
 
         private:
@@ -332,6 +345,289 @@ namespace winrt::impl
         }
     };
 
+    struct timer_wheel_entry
+    {
+        timer_wheel_entry* next{};
+        timer_wheel_entry* prev{};
+        uint64_t deadline{};
+        uint32_t level{};
+        uint32_t slot{};
+        bool linked{};
+        coroutine_handle<> handle;
+    };
+
+    // A hierarchical timer wheel with a resolution of one millisecond that multiplexes every resume_after deadline
+    // onto a single thread pool timer, which is armed only for the next tick that has anything to do. Each of its
+    // four levels has 256 slots, each covering 256 times the span of a slot in the level below, and entries cascade
+    // down a level as their deadline draws near. The wheel is never destroyed, so that a timer that fires during
+    // shutdown does not find it gone.
+    struct timer_wheel
+    {
+        void insert(timer_wheel_entry& entry, Windows::Foundation::TimeSpan const duration)
+        {
+            slim_lock_guard const guard(m_lock);
+
+            if (!m_timer)
+            {
+                m_timer = check_pointer(WINRT_IMPL_CreateThreadpoolTimer(callback, this, nullptr));
+                m_start = std::chrono::steady_clock::now();
+            }
+
+            // The current tick has already partly passed, so the deadline is rounded up to the tick after.
+            auto const ticks = (duration.count() + 9'999) / 10'000;
+            entry.deadline = (std::max)(now() + static_cast<uint64_t>(ticks) + 1, m_current + 1);
+            link(entry);
+
+            if (entry.deadline < m_armed)
+            {
+                arm(entry.deadline);
+            }
+        }
+
+        // Returns true if the entry was removed before its deadline, in which case the wheel will not resume it.
+        bool remove(timer_wheel_entry& entry) noexcept
+        {
+            slim_lock_guard const guard(m_lock);
+
+            if (!entry.linked)
+            {
+                return false;
+            }
+
+            unlink(entry);
+            return true;
+        }
+
+        uint32_t size() noexcept
+        {
+            slim_lock_guard const guard(m_lock);
+            return m_count[0] + m_count[1] + m_count[2] + m_count[3];
+        }
+
+    private:
+
+        static constexpr uint32_t levels{ 4 };
+        static constexpr uint32_t slot_bits{ 8 };
+        static constexpr uint32_t slots{ 1 << slot_bits };
+        static constexpr uint64_t horizon{ (1ull << (levels * slot_bits)) - 1 };
+        static constexpr uint64_t never{ ~0ull };
+
+        uint64_t now() const noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - m_start).count());
+        }
+
+        void link(timer_wheel_entry& entry) noexcept
+        {
+            // Deadlines beyond the last level wait in its furthest slot and are placed again when it cascades.
+            auto const deadline = (std::min)(entry.deadline, m_current + horizon);
+            auto const delta = deadline - m_current;
+            uint32_t level{};
+
+            while (level < levels - 1 && delta >= (1ull << ((level + 1) * slot_bits)))
+            {
+                ++level;
+            }
+
+            entry.level = level;
+            entry.slot = static_cast<uint32_t>(deadline >> (level * slot_bits)) & (slots - 1);
+            entry.prev = nullptr;
+            entry.next = m_slots[level][entry.slot];
+            entry.linked = true;
+
+            if (entry.next)
+            {
+                entry.next->prev = &entry;
+            }
+
+            m_slots[level][entry.slot] = &entry;
+            ++m_count[level];
+        }
+
+        void unlink(timer_wheel_entry& entry) noexcept
+        {
+            if (entry.prev)
+            {
+                entry.prev->next = entry.next;
+            }
+            else
+            {
+                m_slots[entry.level][entry.slot] = entry.next;
+            }
+
+            if (entry.next)
+            {
+                entry.next->prev = entry.prev;
+            }
+
+            entry.linked = false;
+            --m_count[entry.level];
+        }
+
+        // Moves the entries in a slot to the list of entries to fire, or down to a lower level.
+        void cascade(uint32_t const level, uint32_t const slot, timer_wheel_entry*& fired) noexcept
+        {
+            auto entry = std::exchange(m_slots[level][slot], nullptr);
+
+            while (entry)
+            {
+                auto next = entry->next;
+                entry->linked = false;
+                --m_count[level];
+
+                if (entry->deadline <= m_current)
+                {
+                    entry->next = fired;
+                    fired = entry;
+                }
+                else
+                {
+                    link(*entry);
+                }
+
+                entry = next;
+            }
+        }
+
+        // Advances the wheel to the given tick, collecting the entries that are due.
+        timer_wheel_entry* advance(uint64_t const target) noexcept
+        {
+            timer_wheel_entry* fired{};
+
+            while (m_current < target)
+            {
+                uint32_t lowest{};
+
+                while (lowest < levels && m_count[lowest] == 0)
+                {
+                    ++lowest;
+                }
+
+                if (lowest == levels)
+                {
+                    m_current = target;
+                    break;
+                }
+
+                // Nothing below the lowest occupied level can change before its next slot boundary.
+                auto const span = 1ull << (lowest * slot_bits);
+                auto const next = (m_current | (span - 1)) + 1;
+
+                if (next > target)
+                {
+                    m_current = target;
+                    break;
+                }
+
+                m_current = next;
+
+                for (uint32_t level = levels - 1; level > 0; --level)
+                {
+                    if ((m_current & ((1ull << (level * slot_bits)) - 1)) == 0)
+                    {
+                        cascade(level, static_cast<uint32_t>(m_current >> (level * slot_bits)) & (slots - 1), fired);
+                    }
+                }
+
+                cascade(0, static_cast<uint32_t>(m_current) & (slots - 1), fired);
+            }
+
+            return fired;
+        }
+
+        // Returns the next tick at which the wheel has something to do. That is either the next occupied slot in the
+        // lowest level or the next slot boundary of the lowest occupied higher level, where entries cascade down and
+        // may be due, whichever comes first.
+        uint64_t next_tick() const noexcept
+        {
+            uint64_t result{ never };
+
+            for (uint32_t level = 1; level < levels; ++level)
+            {
+                if (m_count[level])
+                {
+                    auto const span = 1ull << (level * slot_bits);
+                    result = (m_current | (span - 1)) + 1;
+                    break;
+                }
+            }
+
+            if (m_count[0])
+            {
+                for (uint64_t tick = m_current + 1; tick < result; ++tick)
+                {
+                    if (m_slots[0][tick & (slots - 1)])
+                    {
+                        return tick;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        void arm(uint64_t const tick) noexcept
+        {
+            m_armed = tick;
+
+            if (tick != never)
+            {
+                auto const current = now();
+                int64_t relative_count = -static_cast<int64_t>(tick > current ? (tick - current) * 10'000 : 0);
+                WINRT_IMPL_SetThreadpoolTimer(m_timer, &relative_count, 0, 0);
+            }
+        }
+
+        static void __stdcall callback(void*, void* context, void*) noexcept
+        {
+            auto that = static_cast<timer_wheel*>(context);
+            timer_wheel_entry* fired;
+
+            {
+                slim_lock_guard const guard(that->m_lock);
+                fired = that->advance(that->now());
+                that->arm(that->next_tick());
+            }
+
+            // Coroutines that are due together are resumed on the thread pool, except the last, which is resumed on
+            // this thread, so that one of them running for a while does not hold up the rest.
+            while (fired)
+            {
+                auto handle = fired->handle;
+                fired = fired->next;
+
+                if (fired)
+                {
+                    try
+                    {
+                        resume_background(handle);
+                        continue;
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+
+                handle();
+            }
+        }
+
+        slim_mutex m_lock;
+        ptp_timer m_timer{};
+        std::chrono::steady_clock::time_point m_start{};
+        uint64_t m_current{};
+        uint64_t m_armed{ never };
+        uint32_t m_count[levels]{};
+        timer_wheel_entry* m_slots[levels][slots]{};
+    };
+
+    inline timer_wheel& get_timer_wheel() noexcept
+    {
+        static_assert(std::is_trivially_destructible_v<timer_wheel>);
+        static timer_wheel wheel;
+        return wheel;
+    }
+
     struct timespan_awaiter : cancellable_awaiter<timespan_awaiter>
     {
         explicit timespan_awaiter(Windows::Foundation::TimeSpan duration) noexcept :
@@ -348,7 +644,8 @@ namespace winrt::impl
             m_timer{std::move(other.m_timer)},
             m_duration{std::move(other.m_duration)},
             m_handle{std::move(other.m_handle)},
-            m_state{other.m_state.load()}
+            m_state{other.m_state.load()},
+            m_wheel{other.m_wheel}
         {}
 #endif
 
@@ -375,7 +672,23 @@ namespace winrt::impl
             set_cancellable_promise_from_handle(handle);
 
             m_handle = handle;
-            create_threadpool_timer();
+
+            if (winrt_timer_wheel_enabled)
+            {
+                m_wheel = true;
+                m_entry.handle = handle;
+                get_timer_wheel().insert(m_entry, m_duration);
+
+                state expected = state::idle;
+                if (!m_state.compare_exchange_strong(expected, state::pending, std::memory_order_release))
+                {
+                    fire_immediately();
+                }
+            }
+            else
+            {
+                create_threadpool_timer();
+            }
         }
 
         void await_resume()
@@ -402,7 +715,15 @@ namespace winrt::impl
 
         void fire_immediately() noexcept
         {
-            if (WINRT_IMPL_SetThreadpoolTimerEx(m_timer.get(), nullptr, 0, 0))
+            if (m_wheel)
+            {
+                // Once the wheel has removed the entry, it resumes the coroutine itself.
+                if (get_timer_wheel().remove(m_entry))
+                {
+                    resume_background_or_inline(m_handle);
+                }
+            }
+            else if (WINRT_IMPL_SetThreadpoolTimerEx(m_timer.get(), nullptr, 0, 0))
             {
                 int64_t now = 0;
                 WINRT_IMPL_SetThreadpoolTimer(m_timer.get(), &now, 0, 0);
@@ -436,6 +757,8 @@ namespace winrt::impl
         Windows::Foundation::TimeSpan m_duration;
         impl::coroutine_handle<> m_handle;
         std::atomic<state> m_state{ state::idle };
+        bool m_wheel{};
+        timer_wheel_entry m_entry;
     };
 
     struct signal_awaiter : cancellable_awaiter<signal_awaiter>
@@ -659,6 +982,571 @@ WINRT_EXPORT namespace winrt
         environment m_environment;
     };
 
+    struct executor_work
+    {
+        void(__stdcall* callback)(void*, void* context);
+        void* context;
+    };
+
+    // A pool of threads that each keep their own queue of work and take work from each other's queues once their
+    // own is empty. Work submitted from one of the executor's own threads goes to that thread's LIFO slot, so a
+    // coroutine that hops back onto the executor continues on the same warm thread as soon as the current callback
+    // returns. No other thread is woken for it, and another thread takes it only if the callback that submitted it
+    // is still running after a while, as it would be if it blocked waiting for that work. Work submitted from other
+    // threads goes to a shared queue that the threads take from in batches. Unlike thread_pool, the executor uses
+    // only standard threads and slim locks. The Win32 thread pool only takes work that arrives once the executor's
+    // threads have exited.
+    struct work_stealing_executor
+    {
+        explicit work_stealing_executor(uint32_t const threads = 0)
+        {
+            m_worker_count = threads ? threads : (std::max)(1u, std::thread::hardware_concurrency());
+            m_workers = std::make_unique<worker[]>(m_worker_count);
+            m_threads.reserve(m_worker_count);
+
+            try
+            {
+                for (uint32_t index = 0; index < m_worker_count; ++index)
+                {
+                    m_workers[index].owner = this;
+                    m_workers[index].index = index;
+                    m_threads.emplace_back([this, index] { run(m_workers[index]); });
+                    ++m_running;
+                }
+            }
+            catch (...)
+            {
+                stop();
+                throw;
+            }
+        }
+
+        work_stealing_executor(work_stealing_executor const&) = delete;
+        work_stealing_executor& operator=(work_stealing_executor const&) = delete;
+
+        // Runs any work that is still queued before returning, so it must not be called from the executor's threads.
+        ~work_stealing_executor()
+        {
+            {
+                // Waits for any resume_background that is already submitting to this executor.
+                slim_lock_guard const guard(default_lock());
+
+                if (default_executor() == this)
+                {
+                    if (winrt_resume_background_handler == submit_default)
+                    {
+                        winrt_resume_background_handler = nullptr;
+                    }
+
+                    default_executor() = nullptr;
+                }
+            }
+
+            stop();
+        }
+
+        // Routes resume_background, and the other hops that the library makes to the thread pool, to this executor
+        // until it is destroyed.
+        void make_default() noexcept
+        {
+            slim_lock_guard const guard(default_lock());
+            default_executor() = this;
+            winrt_resume_background_handler = submit_default;
+        }
+
+        uint32_t thread_count() const noexcept
+        {
+            return m_worker_count;
+        }
+
+        void submit(void(__stdcall* callback)(void*, void* context), void* context)
+        {
+            executor_work const work{ callback, context };
+            worker* const self = current_worker();
+
+            if (self && self->owner == this)
+            {
+                bool displaced;
+
+                {
+                    slim_lock_guard const guard(self->lock);
+                    displaced = self->lifo.callback != nullptr;
+
+                    if (displaced)
+                    {
+                        self->queue.push(self->lifo);
+                    }
+
+                    self->lifo = work;
+                }
+
+                // Only work displaced to the queue counts as pending, since the slot is left to this thread.
+                if (displaced)
+                {
+                    m_pending.fetch_add(1);
+                    wake(1);
+                }
+            }
+            else
+            {
+                {
+                    slim_lock_guard const guard(m_queue_lock);
+                    m_queue.push(work);
+                }
+
+                m_pending.fetch_add(1);
+                wake(1);
+                check_stopped();
+            }
+        }
+
+        // Queues the work under a single lock and wakes as many threads as it needs at once.
+        void submit(array_view<executor_work const> work)
+        {
+            if (work.empty())
+            {
+                return;
+            }
+
+            worker* const self = current_worker();
+
+            {
+                bool const local = self && self->owner == this;
+                slim_lock_guard const guard(local ? self->lock : m_queue_lock);
+                auto& queue = local ? self->queue : m_queue;
+
+                for (auto&& item : work)
+                {
+                    queue.push(item);
+                }
+            }
+
+            m_pending.fetch_add(work.size());
+            wake(work.size());
+            check_stopped();
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_resume() const noexcept
+        {
+        }
+
+        void await_suspend(impl::coroutine_handle<> handle)
+        {
+            submit(impl::resume_background_callback, handle.address());
+        }
+
+    private:
+
+        static constexpr uint32_t lifo_limit{ 8 };
+        static constexpr uint32_t batch_limit{ 32 };
+        static constexpr std::chrono::milliseconds rescue_interval{ 10 };
+
+        struct work_queue
+        {
+            bool empty() const noexcept
+            {
+                return m_head == m_items.size();
+            }
+
+            uint32_t size() const noexcept
+            {
+                return static_cast<uint32_t>(m_items.size() - m_head);
+            }
+
+            void push(executor_work const& work)
+            {
+                if (m_head >= batch_limit && m_head * 2 >= m_items.size())
+                {
+                    m_items.erase(m_items.begin(), m_items.begin() + m_head);
+                    m_head = 0;
+                }
+
+                m_items.push_back(work);
+            }
+
+            executor_work pop() noexcept
+            {
+                auto const work = m_items[m_head++];
+
+                if (empty())
+                {
+                    m_items.clear();
+                    m_head = 0;
+                }
+
+                return work;
+            }
+
+        private:
+
+            std::vector<executor_work> m_items;
+            size_t m_head{};
+        };
+
+        struct alignas(64) worker
+        {
+            slim_mutex lock;
+            work_queue queue;
+            executor_work lifo{};
+            uint32_t lifo_runs{};
+            uint32_t index{};
+            work_stealing_executor* owner{};
+
+            // Counts the callbacks that this thread has started. The watching thread records the count it last saw
+            // while the LIFO slot was full, under the lock.
+            std::atomic<uint32_t> generation{};
+            uint32_t watched{};
+        };
+
+        static worker*& current_worker() noexcept
+        {
+            static thread_local worker* value{};
+            return value;
+        }
+
+        static work_stealing_executor*& default_executor() noexcept
+        {
+            static work_stealing_executor* value{};
+            return value;
+        }
+
+        static slim_mutex& default_lock() noexcept
+        {
+            static slim_mutex value;
+            return value;
+        }
+
+        static int32_t __stdcall submit_default(void(__stdcall* callback)(void*, void* context), void* context) noexcept
+        {
+            try
+            {
+                slim_shared_lock_guard const guard(default_lock());
+
+                // The handler may still be called once the default executor has started to be destroyed.
+                if (auto executor = default_executor())
+                {
+                    executor->submit(callback, context);
+                }
+                else if (!WINRT_IMPL_TrySubmitThreadpoolCallback(callback, context, nullptr))
+                {
+                    throw_last_error();
+                }
+
+                return 0;
+            }
+            catch (...)
+            {
+                return to_hresult();
+            }
+        }
+
+        void wake(size_t const count) noexcept
+        {
+            // A thread counts itself as sleeping before checking for pending work, and work is counted as pending
+            // before this checks for sleeping threads, so one of the two always sees the other.
+            if (m_sleeping.load() == 0)
+            {
+                return;
+            }
+
+            slim_lock_guard const guard(m_lock);
+
+            if (count == 1)
+            {
+                m_cv.notify_one();
+            }
+            else
+            {
+                m_cv.notify_all();
+            }
+        }
+
+        // Work that is queued once every thread has exited would never run, so it goes to the Win32 thread pool.
+        void check_stopped()
+        {
+            if (!m_stopping.load())
+            {
+                return;
+            }
+
+            slim_lock_guard const guard(m_lock);
+
+            if (m_running != 0)
+            {
+                return;
+            }
+
+            while (true)
+            {
+                executor_work work;
+
+                {
+                    slim_lock_guard const queue_guard(m_queue_lock);
+
+                    if (m_queue.empty())
+                    {
+                        return;
+                    }
+
+                    work = m_queue.pop();
+                }
+
+                m_pending.fetch_sub(1);
+
+                if (!WINRT_IMPL_TrySubmitThreadpoolCallback(work.callback, work.context, nullptr))
+                {
+                    throw_last_error();
+                }
+            }
+        }
+
+        void stop() noexcept
+        {
+            {
+                slim_lock_guard const guard(m_lock);
+                m_stopping = true;
+            }
+
+            m_cv.notify_all();
+
+            for (auto&& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        void run(worker& self) noexcept
+        {
+            current_worker() = &self;
+            bool watched{};
+
+            while (true)
+            {
+                executor_work work;
+                bool lifo{};
+
+                if (take(self, work, lifo) || take_shared(self, work) || steal(self, work) || (watched && (lifo = rescue(self, work))))
+                {
+                    if (!lifo)
+                    {
+                        m_pending.fetch_sub(1);
+                    }
+
+                    self.generation.store(self.generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                    work.callback(nullptr, work.context);
+                    watched = false;
+                    continue;
+                }
+
+                watched = false;
+                slim_lock_guard const guard(m_lock);
+                ++m_sleeping;
+
+                // A thread that is still running a callback may yet block on the work in its LIFO slot, so threads
+                // exit only once none is.
+                auto const idle = [&] { return m_stopping && m_sleeping == m_running; };
+                auto const ready = [&] { return m_pending.load() > 0 || idle(); };
+
+                if (idle())
+                {
+                    m_cv.notify_all();
+                }
+
+                // While any thread is running a callback, one sleeping thread at a time wakes up every so often to
+                // look for a LIFO slot whose thread is still running the same callback as the last time it looked.
+                while (!ready())
+                {
+                    if (m_watching || m_sleeping == m_worker_count)
+                    {
+                        m_cv.wait(m_lock, [&] { return ready() || (!m_watching && m_sleeping < m_worker_count); });
+                    }
+                    else
+                    {
+                        m_watching = true;
+                        watched = !m_cv.wait_for(m_lock, rescue_interval, ready);
+                        m_watching = false;
+
+                        if (watched)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                if (!watched && m_pending.load() <= 0 && idle())
+                {
+                    --m_sleeping;
+                    --m_running;
+                    return;
+                }
+
+                --m_sleeping;
+
+                // Another sleeping thread takes over watching while this one runs work. A watching thread that is
+                // only going to look at the LIFO slots keeps watching, and hands over only if it takes one.
+                if (!watched && !m_watching && m_sleeping != 0)
+                {
+                    m_cv.notify_one();
+                }
+            }
+        }
+
+        bool take(worker& self, executor_work& work, bool& lifo) noexcept
+        {
+            slim_lock_guard const guard(self.lock);
+
+            // The LIFO slot may only run so many times in a row, so that a chain of continuations cannot keep the
+            // rest of the queue waiting.
+            if (self.lifo.callback && (self.lifo_runs < lifo_limit || self.queue.empty()))
+            {
+                work = std::exchange(self.lifo, {});
+                ++self.lifo_runs;
+                lifo = true;
+                return true;
+            }
+
+            self.lifo_runs = 0;
+
+            if (self.queue.empty())
+            {
+                return false;
+            }
+
+            work = self.queue.pop();
+            return true;
+        }
+
+        bool take_shared(worker& self, executor_work& work)
+        {
+            std::array<executor_work, batch_limit> batch;
+            uint32_t count{};
+
+            {
+                slim_lock_guard const guard(m_queue_lock);
+                count = (std::min)(m_queue.size(), (std::min)(m_queue.size() / m_worker_count + 1, batch_limit));
+
+                for (uint32_t index = 0; index < count; ++index)
+                {
+                    batch[index] = m_queue.pop();
+                }
+            }
+
+            return keep_batch(self, batch.data(), count, work);
+        }
+
+        bool steal(worker& self, executor_work& work)
+        {
+            for (uint32_t offset = 1; offset < m_worker_count; ++offset)
+            {
+                worker& victim = m_workers[(self.index + offset) % m_worker_count];
+                std::array<executor_work, batch_limit> batch;
+                uint32_t count{};
+
+                {
+                    slim_lock_guard const guard(victim.lock);
+
+                    if (!victim.queue.empty())
+                    {
+                        count = (std::min)((victim.queue.size() + 1) / 2, batch_limit);
+
+                        for (uint32_t index = 0; index < count; ++index)
+                        {
+                            batch[index] = victim.queue.pop();
+                        }
+                    }
+                }
+
+                if (keep_batch(self, batch.data(), count, work))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        // Takes the LIFO slot of a thread that has not started another callback since the last time the watching
+        // thread looked, one watch interval ago, and records what it saw of the others.
+        bool rescue(worker& self, executor_work& work) noexcept
+        {
+            for (uint32_t offset = 1; offset < m_worker_count; ++offset)
+            {
+                worker& victim = m_workers[(self.index + offset) % m_worker_count];
+
+                {
+                    slim_lock_guard const guard(victim.lock);
+
+                    if (!victim.lifo.callback)
+                    {
+                        continue;
+                    }
+
+                    uint32_t const generation = victim.generation.load(std::memory_order_relaxed);
+
+                    if (victim.watched != generation)
+                    {
+                        victim.watched = generation;
+                        continue;
+                    }
+
+                    work = std::exchange(victim.lifo, {});
+                }
+
+                slim_lock_guard const guard(m_lock);
+
+                if (!m_watching && m_sleeping != 0)
+                {
+                    m_cv.notify_one();
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+
+        // Returns the first of the batch and queues the rest on this thread.
+        static bool keep_batch(worker& self, executor_work const* batch, uint32_t const count, executor_work& work)
+        {
+            if (count == 0)
+            {
+                return false;
+            }
+
+            work = batch[0];
+
+            if (count > 1)
+            {
+                slim_lock_guard const guard(self.lock);
+
+                for (uint32_t index = 1; index < count; ++index)
+                {
+                    self.queue.push(batch[index]);
+                }
+            }
+
+            return true;
+        }
+
+        std::unique_ptr<worker[]> m_workers;
+        uint32_t m_worker_count{};
+        std::vector<std::thread> m_threads;
+        slim_mutex m_queue_lock;
+        work_queue m_queue;
+        slim_mutex m_lock;
+        slim_condition_variable m_cv;
+        std::atomic<int64_t> m_pending{};
+        std::atomic<uint32_t> m_sleeping{};
+        std::atomic<bool> m_stopping{};
+        uint32_t m_running{};
+        bool m_watching{};
+    };
+
     struct fire_and_forget {};
 }
 
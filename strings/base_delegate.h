@@ -6,6 +6,8 @@ namespace winrt::impl
 #pragma warning(disable:4458) // declaration hides class member (okay because we do not use named members of base class)
 #endif
 
+    struct delegate_pool;
+
     struct implements_delegate_base
     {
         WINRT_IMPL_NOINLINE uint32_t increment_reference() noexcept
@@ -37,9 +39,256 @@ namespace winrt::impl
         }
 
     private:
+        friend delegate_pool;
         atomic_ref_count m_references{ 1 };
+        bool m_pooled{};
+    };
+
+    // Handlers without state, such as lambdas without captures, are all alike. When winrt_delegate_sharing_enabled is
+    // set, every delegate for a given handler type shares a single instance that is never destroyed, so registering
+    // the same handler twice yields the same delegate and the same event token.
+    template <typename H>
+    inline constexpr bool is_stateless_handler_v = std::is_empty_v<H> && std::is_trivially_destructible_v<H>;
+
+    template <typename D>
+    struct stateless_delegate
+    {
+        // The shared instance keeps a reference of its own and holds the module lock only while it has others. Only
+        // this function can take its count from one to two, since any other caller already holds a reference, so the
+        // lock is taken before the count can get there and released again if it was already higher. Release gives up
+        // the lock only after the count has returned to one, so it is held whenever other references exist.
+        template <typename H>
+        static D* get(H&& handler)
+        {
+            static D* const instance = [&]
+            {
+                auto result = new (storage()) D(std::forward<H>(handler));
+                --get_module_lock();
+                return result;
+            }();
+
+            ++get_module_lock();
+
+            if (instance->AddRef() != 2)
+            {
+                --get_module_lock();
+            }
+
+            return instance;
+        }
+
+        static bool is_shared(D const* const object) noexcept
+        {
+            return object == static_cast<void const*>(storage());
+        }
+
+    private:
+
+        static void* storage() noexcept
+        {
+            alignas(D) static unsigned char buffer[sizeof(D)];
+            return buffer;
+        }
     };
 
+    // A per-thread cache of blocks from operator new in ClassCount size classes, the smallest of MinSize bytes and each
+    // twice the size of the one before. The delegate and coroutine frame pools each have their own, named by Tag.
+    template <typename Tag, uint32_t ClassCount, size_t MinSize, uint32_t MaxCached>
+    struct size_class_cache
+    {
+        static constexpr uint32_t class_count{ ClassCount };
+
+        static constexpr size_t class_size(uint32_t const index) noexcept
+        {
+            return MinSize << index;
+        }
+
+        // Returns class_count if the size is larger than the largest class.
+        static constexpr uint32_t class_index(size_t const size) noexcept
+        {
+            uint32_t index{};
+
+            while (index < class_count && size > class_size(index))
+            {
+                ++index;
+            }
+
+            return index;
+        }
+
+        static void* allocate(uint32_t const index)
+        {
+            auto& cache = get_state();
+
+            if (auto cached = cache.heads[index])
+            {
+                cache.heads[index] = cached->next;
+                --cache.counts[index];
+                return cached;
+            }
+
+            return ::operator new(class_size(index));
+        }
+
+        // The block goes back to the heap if this thread's cache is full or the thread is exiting.
+        static void deallocate(void* const block, uint32_t const index) noexcept
+        {
+            static thread_local cleanup registration;
+            (void)&registration;
+            auto& cache = get_state();
+
+            if (!cache.closed && cache.counts[index] < MaxCached)
+            {
+                auto cached = static_cast<free_block*>(block);
+                cached->next = cache.heads[index];
+                cache.heads[index] = cached;
+                ++cache.counts[index];
+                return;
+            }
+
+            ::operator delete(block);
+        }
+
+    private:
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Trivially destructible so that blocks released by other thread_local destructors can still use it.
+        struct state
+        {
+            free_block* heads[class_count];
+            uint32_t counts[class_count];
+            bool closed;
+        };
+
+        struct cleanup
+        {
+            ~cleanup() noexcept
+            {
+                auto& cache = get_state();
+                cache.closed = true;
+
+                for (uint32_t index = 0; index < class_count; ++index)
+                {
+                    while (auto block = cache.heads[index])
+                    {
+                        cache.heads[index] = block->next;
+                        ::operator delete(block);
+                    }
+
+                    cache.counts[index] = 0;
+                }
+            }
+        };
+
+        static state& get_state() noexcept
+        {
+            static thread_local state cache{};
+            return cache;
+        }
+    };
+
+    // When winrt_delegate_pool_enabled is set, delegates with small handlers are given a whole size class, and once
+    // released are kept in a per-thread cache for reuse by the next delegate of the same size class created on that
+    // thread. Delegates created while the pool is disabled are allocated individually at their own size and are never
+    // cached; each delegate records which way it was allocated.
+    struct delegate_pool
+    {
+        using cache = size_class_cache<delegate_pool, 4, 32, 64>;
+
+        template <typename D>
+        static constexpr uint32_t class_index() noexcept
+        {
+            if constexpr (alignof(D) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            {
+                return cache::class_count;
+            }
+            else
+            {
+                return cache::class_index(sizeof(D));
+            }
+        }
+
+        template <typename D, typename H>
+        static D* create(H&& handler)
+        {
+            constexpr uint32_t index = class_index<D>();
+
+            if constexpr (index < cache::class_count)
+            {
+                if (winrt_delegate_pool_enabled)
+                {
+                    void* block = cache::allocate(index);
+                    D* result;
+
+                    try
+                    {
+                        result = new (block) D(std::forward<H>(handler));
+                    }
+                    catch (...)
+                    {
+                        deallocate(block, index);
+                        throw;
+                    }
+
+                    result->m_pooled = true;
+                    return result;
+                }
+            }
+
+            return new D(std::forward<H>(handler));
+        }
+
+        template <typename D>
+        static void destroy(D* const object) noexcept
+        {
+            constexpr uint32_t index = class_index<D>();
+
+            if constexpr (index < cache::class_count)
+            {
+                if (object->m_pooled)
+                {
+                    object->~D();
+                    deallocate(object, index);
+                    return;
+                }
+            }
+
+            delete object;
+        }
+
+    private:
+
+        static void deallocate(void* const block, uint32_t const index) noexcept
+        {
+            if (winrt_delegate_pool_enabled)
+            {
+                cache::deallocate(block, index);
+            }
+            else
+            {
+                ::operator delete(block);
+            }
+        }
+    };
+
+    template <typename D, typename H>
+    D* create_delegate(H&& handler)
+    {
+        if constexpr (is_stateless_handler_v<H>)
+        {
+            if (winrt_delegate_sharing_enabled)
+            {
+                return stateless_delegate<D>::get(std::forward<H>(handler));
+            }
+        }
+
+        return delegate_pool::create<D>(std::forward<H>(handler));
+    }
+
     template <typename T, typename H>
     struct implements_delegate : abi_t<T>, implements_delegate_base, H, update_module_lock
     {
@@ -61,9 +310,22 @@ namespace winrt::impl
         {
             auto const remaining = decrement_reference();
 
+            if constexpr (is_stateless_handler_v<H>)
+            {
+                if (stateless_delegate<delegate<T, H>>::is_shared(static_cast<delegate<T, H>*>(this)))
+                {
+                    if (remaining == 1)
+                    {
+                        --get_module_lock();
+                    }
+
+                    return remaining;
+                }
+            }
+
             if (remaining == 0)
             {
-                delete static_cast<delegate<T, H>*>(this);
+                delegate_pool::destroy(static_cast<delegate<T, H>*>(this));
             }
 
             return remaining;
@@ -73,7 +335,7 @@ namespace winrt::impl
     template <typename T, typename H>
     T make_delegate(H&& handler)
     {
-        return { static_cast<void*>(static_cast<abi_t<T>*>(new delegate<T, H>(std::forward<H>(handler)))), take_ownership_from_abi };
+        return { static_cast<void*>(static_cast<abi_t<T>*>(create_delegate<delegate<T, H>>(std::forward<H>(handler)))), take_ownership_from_abi };
     }
 
     template <typename T>
@@ -147,9 +409,22 @@ namespace winrt::impl
         {
             auto const remaining = decrement_reference();
 
+            if constexpr (is_stateless_handler_v<H>)
+            {
+                if (stateless_delegate<variadic_delegate>::is_shared(this))
+                {
+                    if (remaining == 1)
+                    {
+                        --get_module_lock();
+                    }
+
+                    return remaining;
+                }
+            }
+
             if (remaining == 0)
             {
-                delete this;
+                delegate_pool::destroy(this);
             }
 
             return remaining;
@@ -211,7 +486,7 @@ namespace winrt::impl
         template <typename H>
         static delegate_base<R, Args...> make(H&& handler)
         {
-            return { static_cast<void*>(new variadic_delegate<H, R, Args...>(std::forward<H>(handler))), take_ownership_from_abi };
+            return { static_cast<void*>(create_delegate<variadic_delegate<H, R, Args...>>(std::forward<H>(handler))), take_ownership_from_abi };
         }
     };
 
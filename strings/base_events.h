@@ -525,4 +525,253 @@ WINRT_EXPORT namespace winrt
         slim_mutex m_swap;
         slim_mutex m_change;
     };
+
+    // An event for handlers that are invoked often and from many threads. Invocation takes no lock. It registers with
+    // the event's reader epochs and uses whichever array of handlers is current. Adding or removing a handler replaces
+    // the array under a lock, just as for event. A replaced array is released once no invocation can still be using
+    // it. That is checked whenever the handlers change and whenever an invocation finishes while arrays are waiting
+    // to be released. The reader epochs make this event take several cache lines more memory than event.
+    template <typename Delegate>
+    struct lock_free_event
+    {
+        using delegate_type = Delegate;
+
+        lock_free_event() = default;
+        lock_free_event(lock_free_event const&) = delete;
+        lock_free_event& operator =(lock_free_event const&) = delete;
+
+        ~lock_free_event() noexcept
+        {
+            release(m_targets.load(std::memory_order_relaxed));
+
+            for (auto&& [targets, epoch] : m_retired)
+            {
+                release(targets);
+            }
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return m_targets.load(std::memory_order_relaxed) != nullptr;
+        }
+
+        event_token add(delegate_type const& delegate)
+        {
+            return add_agile(impl::make_agile_delegate(delegate));
+        }
+
+        void remove(event_token const token)
+        {
+            // Collects the arrays that can be released so that their delegates are released outside of the lock.
+            std::vector<array_type*> released;
+
+            {
+                slim_lock_guard const change_guard(m_change);
+                array_type* targets = m_targets.load();
+
+                if (!targets)
+                {
+                    return;
+                }
+
+                uint32_t available_slots = targets->size() - 1;
+                delegate_array new_targets;
+                bool removed = false;
+
+                if (available_slots == 0)
+                {
+                    if (get_token(*targets->begin()) == token)
+                    {
+                        removed = true;
+                    }
+                }
+                else
+                {
+                    new_targets = impl::make_event_array<delegate_type>(available_slots);
+                    auto new_iterator = new_targets->begin();
+
+                    for (delegate_type const& element : *targets)
+                    {
+                        if (!removed && token == get_token(element))
+                        {
+                            removed = true;
+                            continue;
+                        }
+
+                        if (available_slots == 0)
+                        {
+                            WINRT_ASSERT(!removed);
+                            break;
+                        }
+
+                        *new_iterator = element;
+                        ++new_iterator;
+                        --available_slots;
+                    }
+                }
+
+                if (removed)
+                {
+                    replace(new_targets.detach(), released);
+                }
+            }
+
+            release(released);
+        }
+
+        void clear()
+        {
+            std::vector<array_type*> released;
+
+            {
+                slim_lock_guard const change_guard(m_change);
+
+                if (!m_targets.load())
+                {
+                    return;
+                }
+
+                replace(nullptr, released);
+            }
+
+            release(released);
+        }
+
+        template<typename...Arg>
+        void operator()(Arg const&... args)
+        {
+            {
+                impl::reader_epochs::reader const reader(m_readers);
+
+                if (array_type* targets = m_targets.load())
+                {
+                    for (delegate_type const& element : *targets)
+                    {
+                        if (!impl::invoke(element, args...))
+                        {
+                            remove(get_token(element));
+                        }
+                    }
+                }
+            }
+
+            if (m_retiring.load(std::memory_order_relaxed))
+            {
+                reclaim();
+            }
+        }
+
+    private:
+
+        using array_type = impl::event_array<delegate_type>;
+        using delegate_array = com_ptr<array_type>;
+
+        WINRT_IMPL_NOINLINE event_token add_agile(delegate_type delegate)
+        {
+            event_token token{};
+            std::vector<array_type*> released;
+
+            {
+                slim_lock_guard const change_guard(m_change);
+                array_type* targets = m_targets.load();
+                delegate_array new_targets = impl::make_event_array<delegate_type>((!targets) ? 1 : targets->size() + 1);
+
+                if (targets)
+                {
+                    std::copy_n(targets->begin(), targets->size(), new_targets->begin());
+                }
+
+                new_targets->back() = std::move(delegate);
+                token = get_token(new_targets->back());
+                replace(new_targets.detach(), released);
+            }
+
+            release(released);
+            return token;
+        }
+
+        // Publishes the new array and retires the old one. Must be called while holding m_change.
+        void replace(array_type* new_targets, std::vector<array_type*>& released)
+        {
+            // Reserving first means that nothing can fail once the new array has been published.
+            m_retired.reserve(m_retired.size() + 1);
+            released.reserve(m_retired.size() + 1);
+
+            if (array_type* old_targets = m_targets.exchange(new_targets))
+            {
+                m_retired.emplace_back(old_targets, m_readers.current());
+            }
+
+            collect(released);
+        }
+
+        // Moves the retired arrays that no invocation can still be using to released. Must be called while holding
+        // m_change. Without concurrent invocations the epoch advances twice here, so arrays are released right away.
+        void collect(std::vector<array_type*>& released)
+        {
+            released.reserve(m_retired.size());
+
+            if (m_readers.try_advance())
+            {
+                m_readers.try_advance();
+            }
+
+            uint64_t const current = m_readers.current();
+
+            for (auto retired = m_retired.begin(); retired != m_retired.end();)
+            {
+                if (retired->second + 2 <= current)
+                {
+                    released.push_back(retired->first);
+                    retired = m_retired.erase(retired);
+                }
+                else
+                {
+                    ++retired;
+                }
+            }
+
+            m_retiring.store(!m_retired.empty(), std::memory_order_relaxed);
+        }
+
+        WINRT_IMPL_NOINLINE void reclaim()
+        {
+            std::vector<array_type*> released;
+
+            if (m_change.try_lock())
+            {
+                collect(released);
+                m_change.unlock();
+            }
+
+            release(released);
+        }
+
+        static void release(array_type* targets) noexcept
+        {
+            if (targets)
+            {
+                targets->Release();
+            }
+        }
+
+        static void release(std::vector<array_type*> const& released) noexcept
+        {
+            for (auto targets : released)
+            {
+                release(targets);
+            }
+        }
+
+        event_token get_token(delegate_type const& delegate) const noexcept
+        {
+            return event_token{ reinterpret_cast<int64_t>(WINRT_IMPL_EncodePointer(get_abi(delegate))) };
+        }
+
+        std::atomic<array_type*> m_targets{};
+        std::atomic<bool> m_retiring{};
+        std::vector<std::pair<array_type*, uint64_t>> m_retired;
+        impl::reader_epochs m_readers;
+        slim_mutex m_change;
+    };
 }
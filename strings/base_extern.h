@@ -3,6 +3,13 @@ __declspec(selectany) int32_t(__stdcall* winrt_to_hresult_handler)(void* address
 __declspec(selectany) winrt::hstring(__stdcall* winrt_to_message_handler)(void* address) {};
 __declspec(selectany) void(__stdcall* winrt_throw_hresult_handler)(uint32_t lineNumber, char const* fileName, char const* functionName, void* returnAddress, winrt::hresult const result) noexcept {};
 __declspec(selectany) int32_t(__stdcall* winrt_activation_handler)(void* classId, winrt::guid const& iid, void** factory) noexcept {};
+__declspec(selectany) bool winrt_hstring_pool_enabled{};
+__declspec(selectany) bool winrt_coroutine_frame_pool_enabled{};
+__declspec(selectany) void(__stdcall* winrt_coroutine_frame_handler)(void* address, uint32_t size) noexcept {};
+__declspec(selectany) int32_t(__stdcall* winrt_resume_background_handler)(void(__stdcall* callback)(void*, void* context), void* context) noexcept {};
+__declspec(selectany) bool winrt_timer_wheel_enabled{};
+__declspec(selectany) bool winrt_delegate_pool_enabled{};
+__declspec(selectany) bool winrt_delegate_sharing_enabled{};
 
 #if defined(_MSC_VER)
 #ifdef _M_HYBRID
@@ -57,6 +64,7 @@ extern "C"
     int32_t  __stdcall WINRT_IMPL_WideCharToMultiByte(uint32_t codepage, uint32_t flags, wchar_t const* int_string, int32_t in_size, char* out_string, int32_t out_size, char const* default_char, int32_t* default_used) noexcept WINRT_IMPL_LINK(WideCharToMultiByte, 32);
     void* __stdcall    WINRT_IMPL_HeapAlloc(void* heap, uint32_t flags, size_t bytes) noexcept WINRT_IMPL_LINK(HeapAlloc, 12);
     int32_t  __stdcall WINRT_IMPL_HeapFree(void* heap, uint32_t flags, void* value) noexcept WINRT_IMPL_LINK(HeapFree, 12);
+    size_t   __stdcall WINRT_IMPL_HeapSize(void* heap, uint32_t flags, void const* value) noexcept WINRT_IMPL_LINK(HeapSize, 12);
     void*    __stdcall WINRT_IMPL_GetProcessHeap() noexcept WINRT_IMPL_LINK(GetProcessHeap, 0);
     uint32_t __stdcall WINRT_IMPL_FormatMessageW(uint32_t flags, void const* source, uint32_t code, uint32_t language, wchar_t* buffer, uint32_t size, va_list* arguments) noexcept WINRT_IMPL_LINK(FormatMessageW, 28);
     uint32_t __stdcall WINRT_IMPL_GetLastError() noexcept WINRT_IMPL_LINK(GetLastError, 0);
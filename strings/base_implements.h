@@ -409,10 +409,132 @@ namespace winrt::impl
         }
     };
 
+    template <typename List>
+    struct interface_count;
+
+    template <typename... I>
+    struct interface_count<interface_list<I...>> : std::integral_constant<uint32_t, sizeof...(I)> {};
+
+    // Classes implementing at least this many interfaces find the IID in an iid_table rather than comparing it with
+    // each interface's IID in turn.
+    inline constexpr uint32_t iid_table_threshold{ 8 };
+
+    // An open-addressed hash table of a class's interface IIDs, built at compile time, that maps each IID to a cast to
+    // the corresponding interface. Duplicate IIDs keep the first interface, just as the linear search does.
+    template <typename T, typename List = implemented_interfaces<T>>
+    struct iid_table;
+
+    template <typename T, typename... I>
+    struct iid_table<T, interface_list<I...>>
+    {
+        static void* find(T const* obj, guid const& id) noexcept
+        {
+            for (uint32_t slot = hash(id); entries[slot].index != count; slot = (slot + 1) & mask)
+            {
+                if (entries[slot].id == id)
+                {
+                    return casts[entries[slot].index](obj);
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+
+        static constexpr uint32_t count{ sizeof...(I) };
+
+        static constexpr uint32_t get_size() noexcept
+        {
+            uint32_t size = 1;
+
+            while (size < count * 2)
+            {
+                size *= 2;
+            }
+
+            return size;
+        }
+
+        static constexpr uint32_t mask{ get_size() - 1 };
+
+        static constexpr uint32_t hash(guid const& id) noexcept
+        {
+            // IIDs are random or name-based, so a few of their bytes are as good as a hash of all of them.
+            return (id.Data1 ^ (id.Data4[4] | id.Data4[5] << 8 | id.Data4[6] << 16 | static_cast<uint32_t>(id.Data4[7]) << 24)) & mask;
+        }
+
+        static constexpr bool equal(guid const& left, guid const& right) noexcept
+        {
+            for (uint32_t index = 0; index < 8; ++index)
+            {
+                if (left.Data4[index] != right.Data4[index])
+                {
+                    return false;
+                }
+            }
+
+            return left.Data1 == right.Data1 && left.Data2 == right.Data2 && left.Data3 == right.Data3;
+        }
+
+        struct entry
+        {
+            guid id;
+            uint32_t index;
+        };
+
+        static constexpr std::array<entry, mask + 1> get_entries() noexcept
+        {
+#ifdef _MSC_VER
+#pragma warning(suppress: 4307)
+#endif
+            std::array<guid, count> const ids{ guid_of<typename default_interface<I>::type>()... };
+            std::array<entry, mask + 1> result{};
+
+            for (auto&& item : result)
+            {
+                item.index = count;
+            }
+
+            for (uint32_t index = 0; index < count; ++index)
+            {
+                uint32_t slot = hash(ids[index]);
+
+                while (result[slot].index != count && !equal(result[slot].id, ids[index]))
+                {
+                    slot = (slot + 1) & mask;
+                }
+
+                if (result[slot].index == count)
+                {
+                    result[slot] = { ids[index], index };
+                }
+            }
+
+            return result;
+        }
+
+        template <typename Interface>
+        static void* cast(T const* obj) noexcept
+        {
+            return to_abi<Interface>(obj);
+        }
+
+        static constexpr std::array<entry, mask + 1> entries{ get_entries() };
+        static constexpr std::array<void* (*)(T const*) noexcept, count> casts{ &cast<I>... };
+    };
+
     template <typename T>
     auto find_iid(T const* obj, guid const& iid) noexcept
     {
-        return static_cast<unknown_abi*>(implemented_interfaces<T>::find(find_iid_traits<T>{ obj, iid }));
+        if constexpr (interface_count<implemented_interfaces<T>>::value >= iid_table_threshold)
+        {
+            return static_cast<unknown_abi*>(iid_table<T>::find(obj, iid));
+        }
+        else
+        {
+            return static_cast<unknown_abi*>(implemented_interfaces<T>::find(find_iid_traits<T>{ obj, iid }));
+        }
     }
 
     template <typename I>
@@ -184,6 +184,134 @@ namespace winrt::impl
         return std::make_reverse_iterator(get_begin_iterator(collection));
     }
 
+    // An input range over an iterable collection that fetches its elements in batches with IIterator::GetMany rather
+    // than making separate MoveNext and Current calls for each element.
+    template <typename T>
+    struct batched_range
+    {
+        using iterator_type = decltype(std::declval<T const&>().First());
+        using value_type = std::decay_t<decltype(std::declval<iterator_type const&>().Current())>;
+
+        batched_range(T const& collection, uint32_t const size) :
+            m_iterator(collection.First()),
+            m_values((std::max)(size, 1u), empty_value<value_type>())
+        {
+            fill();
+        }
+
+        batched_range(batched_range const&) = delete;
+        batched_range& operator=(batched_range const&) = delete;
+
+        struct iterator
+        {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = typename batched_range::value_type;
+            using difference_type = ptrdiff_t;
+            using pointer = value_type const*;
+            using reference = value_type const&;
+
+            iterator() noexcept = default;
+
+            explicit iterator(batched_range* range) noexcept : m_range(range)
+            {
+            }
+
+            reference operator*() const noexcept
+            {
+                return m_range->m_values[m_range->m_index];
+            }
+
+            pointer operator->() const noexcept
+            {
+                return std::addressof(**this);
+            }
+
+            iterator& operator++()
+            {
+                m_range->next();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                m_range->next();
+            }
+
+            bool operator==(iterator const& other) const noexcept
+            {
+                return done() == other.done();
+            }
+
+            bool operator!=(iterator const& other) const noexcept
+            {
+                return !(*this == other);
+            }
+
+        private:
+
+            bool done() const noexcept
+            {
+                return !m_range || m_range->m_index == m_range->m_count;
+            }
+
+            batched_range* m_range{};
+        };
+
+        iterator begin() noexcept
+        {
+            return iterator{ this };
+        }
+
+        iterator end() noexcept
+        {
+            return {};
+        }
+
+    private:
+
+        void next()
+        {
+            WINRT_ASSERT(m_index < m_count);
+
+            // A short batch means the iterator has already reached the end.
+            if (++m_index == m_count && m_count == m_values.size())
+            {
+                fill();
+            }
+        }
+
+        void fill()
+        {
+            // Under the fill-array contract the callee writes into the slots without releasing what they already hold,
+            // so the previous batch is released first.
+            if constexpr (!std::is_trivially_copyable_v<value_type>)
+            {
+                std::fill_n(m_values.begin(), m_count, empty_value<value_type>());
+            }
+
+            m_index = 0;
+            m_count = m_iterator.GetMany(m_values);
+        }
+
+        iterator_type m_iterator;
+        std::vector<value_type> m_values;
+        uint32_t m_index{};
+        uint32_t m_count{};
+    };
+
     using std::begin;
     using std::end;
 }
+
+WINRT_EXPORT namespace winrt
+{
+    // Iterates over a collection in batches of the given size, which takes one call across the ABI per batch rather
+    // than two per element:
+    //
+    //     for (auto&& value : batched(collection))
+    template <typename T>
+    auto batched(T const& collection, uint32_t const size = 64)
+    {
+        return impl::batched_range<T>{ collection, size };
+    }
+}
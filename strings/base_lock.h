@@ -140,3 +140,187 @@ WINRT_EXPORT namespace winrt
         impl::condition_variable m_cv{};
     };
 }
+
+namespace winrt::impl
+{
+    // Returns a small number that is fixed for the life of the calling thread and differs between threads created
+    // around the same time, for spreading per-thread state over several cache lines.
+    inline uint32_t thread_slot_index() noexcept
+    {
+        static std::atomic<uint32_t> next{};
+        static thread_local uint32_t const index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    // Tracks the readers of a structure that is read without locks, so that a writer can tell when no reader can
+    // still see an object it has replaced. Epochs only move forward. Once the epoch has advanced twice past the
+    // epoch in which an object was replaced, every reader that might have seen it has finished.
+    //
+    // Each reader claims a record of its own, each on its own cache line, and announces the epoch it reads under
+    // there. A thread normally claims the same record as its last read of the same structure, so readers on different
+    // threads don't write the same memory. There are only as many records as readers that were ever active at once.
+    // Writers must be serialized by the caller.
+    struct reader_epochs
+    {
+    private:
+
+        // The announced epoch plus one, or zero while the record is free. A record is claimed by announcing epoch zero,
+        // which at most holds back a writer until the reader announces the current epoch.
+        struct alignas(64) record_type
+        {
+            std::atomic<uint64_t> epoch{};
+            record_type* next{};
+        };
+
+        // The record each thread last claimed, indexed by the owner's id. Ids are never reused, so a
+        // matching id means the record belongs to a live owner.
+        struct hint_type
+        {
+            uint64_t owner;
+            record_type* record;
+        };
+
+    public:
+
+        reader_epochs(reader_epochs const&) = delete;
+        reader_epochs& operator=(reader_epochs const&) = delete;
+
+        reader_epochs() noexcept = default;
+
+        ~reader_epochs() noexcept
+        {
+            for (record_type* record = m_records.load(); record;)
+            {
+                delete std::exchange(record, record->next);
+            }
+        }
+
+        struct reader
+        {
+            explicit reader(reader_epochs const& owner) noexcept : m_record(owner.claim())
+            {
+                // A reader that announces an epoch that is no longer current must announce again, since the writer
+                // that advanced it may have already checked this record.
+                while (true)
+                {
+                    uint64_t const epoch = owner.m_epoch.load();
+                    m_record->epoch.store(epoch + 1);
+
+                    if (owner.m_epoch.load() == epoch)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            reader(reader const&) = delete;
+
+            ~reader() noexcept
+            {
+                m_record->epoch.store(0, std::memory_order_release);
+            }
+
+        private:
+
+            record_type* const m_record;
+        };
+
+        uint64_t current() const noexcept
+        {
+            return m_epoch.load();
+        }
+
+        // Advances the epoch if every reader that announced an earlier epoch has finished.
+        bool try_advance() noexcept
+        {
+            uint64_t const epoch = m_epoch.load();
+
+            for (record_type* record = m_records.load(); record; record = record->next)
+            {
+                uint64_t const announced = record->epoch.load();
+
+                if (announced != 0 && announced != epoch + 1)
+                {
+                    return false;
+                }
+            }
+
+            m_epoch.store(epoch + 1);
+            return true;
+        }
+
+        // Waits until no reader that is active now can still see an object that was replaced before the call.
+        void synchronize() noexcept
+        {
+            for (uint64_t const target = current() + 2; current() < target;)
+            {
+                if (!try_advance())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+
+        static constexpr uint32_t hint_count{ 4 };
+        inline static thread_local hint_type t_hints[hint_count]{};
+
+        static uint64_t next_id() noexcept
+        {
+            static std::atomic<uint64_t> next{};
+            return next.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        static bool try_claim(record_type* record) noexcept
+        {
+            uint64_t expected{};
+            return record->epoch.load(std::memory_order_relaxed) == 0 && record->epoch.compare_exchange_strong(expected, 1);
+        }
+
+        record_type* claim() const noexcept
+        {
+            hint_type& hint = t_hints[m_id % hint_count];
+
+            if (hint.owner == m_id && try_claim(hint.record))
+            {
+                return hint.record;
+            }
+
+            return claim_slow(hint);
+        }
+
+        // Readers can't fail, so a reader that can't allocate a record terminates like any other failure in a
+        // noexcept function. Records are only allocated when more readers are active at once than ever before.
+        WINRT_IMPL_NOINLINE record_type* claim_slow(hint_type& hint) const noexcept
+        {
+            record_type* result{};
+
+            for (record_type* record = m_records.load(); record && !result; record = record->next)
+            {
+                if (try_claim(record))
+                {
+                    result = record;
+                }
+            }
+
+            if (!result)
+            {
+                result = new record_type;
+                result->epoch.store(1, std::memory_order_relaxed);
+                result->next = m_records.load();
+
+                while (!m_records.compare_exchange_weak(result->next, result))
+                {
+                }
+            }
+
+            hint = { m_id, result };
+            return result;
+        }
+
+        std::atomic<uint64_t> m_epoch{};
+        uint64_t const m_id{ next_id() };
+        mutable std::atomic<record_type*> m_records{};
+    };
+}
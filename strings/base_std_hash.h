@@ -1,8 +1,114 @@
 
+#if defined(_MSC_VER)
+#if defined(WINRT_FAST_HASH)
+#pragma detect_mismatch("C++/WinRT WINRT_FAST_HASH", "fast hash enabled")
+#else
+#pragma detect_mismatch("C++/WinRT WINRT_FAST_HASH", "fast hash disabled")
+#endif
+#endif
+
 namespace winrt::impl
 {
+    // A word-at-a-time hash in the style of xxHash64, reading four independent 64-bit lanes per 32-byte block. Used for
+    // hash_data and std::hash<hstring> when WINRT_FAST_HASH is defined.
+    inline uint64_t hash_data_fast(void const* ptr, size_t const bytes) noexcept
+    {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64_t prime3 = 0x165667B19E3779F9ULL;
+        constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ULL;
+        constexpr uint64_t prime5 = 0x27D4EB2F165667C5ULL;
+
+        auto rotate = [](uint64_t const value, int const count) noexcept
+        {
+            return (value << count) | (value >> (64 - count));
+        };
+
+        auto read = [](uint8_t const* const buffer) noexcept
+        {
+            uint64_t value;
+            memcpy(&value, buffer, sizeof(value));
+            return value;
+        };
+
+        auto round = [&](uint64_t accumulator, uint64_t const input) noexcept
+        {
+            accumulator += input * prime2;
+            return rotate(accumulator, 31) * prime1;
+        };
+
+        auto merge = [&](uint64_t accumulator, uint64_t const lane) noexcept
+        {
+            accumulator ^= round(0, lane);
+            return accumulator * prime1 + prime4;
+        };
+
+        uint8_t const* buffer = static_cast<uint8_t const*>(ptr);
+        uint8_t const* const end = buffer + bytes;
+        uint64_t result;
+
+        if (bytes >= 32)
+        {
+            uint64_t lane1 = prime1 + prime2;
+            uint64_t lane2 = prime2;
+            uint64_t lane3 = 0;
+            uint64_t lane4 = 0 - prime1;
+
+            for (; end - buffer >= 32; buffer += 32)
+            {
+                lane1 = round(lane1, read(buffer));
+                lane2 = round(lane2, read(buffer + 8));
+                lane3 = round(lane3, read(buffer + 16));
+                lane4 = round(lane4, read(buffer + 24));
+            }
+
+            result = rotate(lane1, 1) + rotate(lane2, 7) + rotate(lane3, 12) + rotate(lane4, 18);
+            result = merge(result, lane1);
+            result = merge(result, lane2);
+            result = merge(result, lane3);
+            result = merge(result, lane4);
+        }
+        else
+        {
+            result = prime5;
+        }
+
+        result += bytes;
+
+        for (; end - buffer >= 8; buffer += 8)
+        {
+            result ^= round(0, read(buffer));
+            result = rotate(result, 27) * prime1 + prime4;
+        }
+
+        if (end - buffer >= 4)
+        {
+            uint32_t value;
+            memcpy(&value, buffer, sizeof(value));
+            result ^= value * prime1;
+            result = rotate(result, 23) * prime2 + prime3;
+            buffer += 4;
+        }
+
+        for (; buffer != end; ++buffer)
+        {
+            result ^= *buffer * prime5;
+            result = rotate(result, 11) * prime1;
+        }
+
+        result ^= result >> 33;
+        result *= prime2;
+        result ^= result >> 29;
+        result *= prime3;
+        result ^= result >> 32;
+        return result;
+    }
+
     inline size_t hash_data(void const* ptr, size_t const bytes) noexcept
     {
+#if defined(WINRT_FAST_HASH)
+        return static_cast<size_t>(hash_data_fast(ptr, bytes));
+#else
 #ifdef _WIN64
         constexpr size_t fnv_offset_basis = 14695981039346656037ULL;
         constexpr size_t fnv_prime = 1099511628211ULL;
@@ -20,6 +126,7 @@ namespace winrt::impl
         }
 
         return result;
+#endif
     }
 
     struct hash_base
@@ -38,7 +145,11 @@ namespace std
     {
         size_t operator()(winrt::hstring const& value) const noexcept
         {
+#if defined(WINRT_FAST_HASH)
+            return winrt::impl::hash_data(value.data(), sizeof(wchar_t) * value.size());
+#else
             return std::hash<std::wstring_view>{}(value);
+#endif
         }
     };
 
@@ -62,11 +62,135 @@ namespace winrt::impl
         wchar_t buffer[1];
     };
 
+    // When winrt_hstring_pool_enabled is set, small strings are allocated in a few fixed size classes and blocks
+    // released by C++/WinRT are kept in a per-thread cache for reuse. Every block is still an individual allocation
+    // from the process heap, so a string handed across the ABI and freed by WindowsDeleteString (or anything else that
+    // calls HeapFree) stays valid. The header carries nothing that identifies the code that created a string, so a
+    // released block joins the size class that its actual heap size, as reported by HeapSize, can hold.
+    struct hstring_pool
+    {
+        static constexpr uint32_t class_count{ 3 };
+        static constexpr uint32_t max_cached{ 64 };
+
+        static constexpr uint32_t class_size(uint32_t const index) noexcept
+        {
+            return 64u << index;
+        }
+
+        struct free_block
+        {
+            free_block* next;
+        };
+
+        // Trivially destructible so that strings released by other thread_local destructors can still use it.
+        struct state
+        {
+            free_block* heads[class_count];
+            uint32_t counts[class_count];
+            bool closed;
+        };
+
+        struct cleanup
+        {
+            ~cleanup() noexcept
+            {
+                auto& cache = get_state();
+                cache.closed = true;
+
+                for (uint32_t index = 0; index < class_count; ++index)
+                {
+                    while (auto block = cache.heads[index])
+                    {
+                        cache.heads[index] = block->next;
+                        WINRT_IMPL_HeapFree(WINRT_IMPL_GetProcessHeap(), 0, block);
+                    }
+
+                    cache.counts[index] = 0;
+                }
+            }
+        };
+
+        static state& get_state() noexcept
+        {
+            static thread_local state cache{};
+            return cache;
+        }
+
+        static shared_hstring_header* allocate(uint64_t const bytes) noexcept
+        {
+            uint32_t index = 0;
+
+            while (index < class_count && bytes > class_size(index))
+            {
+                ++index;
+            }
+
+            if (index == class_count)
+            {
+                return nullptr;
+            }
+
+            auto& cache = get_state();
+            void* block = cache.heads[index];
+
+            if (block)
+            {
+                cache.heads[index] = cache.heads[index]->next;
+                --cache.counts[index];
+            }
+            else
+            {
+                block = WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, class_size(index));
+            }
+
+            return static_cast<shared_hstring_header*>(block);
+        }
+
+        static bool release(hstring_header* header) noexcept
+        {
+            if (!winrt_hstring_pool_enabled)
+            {
+                return false;
+            }
+
+            // Blocks that are too small for the smallest class, or more than twice the size of the largest, go back
+            // to the heap. HeapSize returns SIZE_MAX on failure, which is never cached either.
+            size_t const size = WINRT_IMPL_HeapSize(WINRT_IMPL_GetProcessHeap(), 0, header);
+
+            if (size < class_size(0) || size >= 2 * size_t{ class_size(class_count - 1) })
+            {
+                return false;
+            }
+
+            uint32_t index = class_count - 1;
+
+            while (size < class_size(index))
+            {
+                --index;
+            }
+
+            static thread_local cleanup registration;
+            (void)&registration;
+            auto& cache = get_state();
+
+            if (cache.closed || cache.counts[index] == max_cached)
+            {
+                return false;
+            }
+
+            auto block = reinterpret_cast<free_block*>(header);
+            block->next = cache.heads[index];
+            cache.heads[index] = block;
+            ++cache.counts[index];
+            return true;
+        }
+    };
+
     inline void release_hstring(hstring_header* handle) noexcept
     {
         WINRT_ASSERT((handle->flags & hstring_reference_flag) == 0);
 
-        if (0 == --static_cast<shared_hstring_header*>(handle)->count)
+        if (0 == --static_cast<shared_hstring_header*>(handle)->count && !hstring_pool::release(handle))
         {
             WINRT_IMPL_HeapFree(WINRT_IMPL_GetProcessHeap(), 0, handle);
         }
@@ -82,11 +206,21 @@ namespace winrt::impl
             throw std::invalid_argument("length");
         }
 
-        auto header = static_cast<shared_hstring_header*>(WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, static_cast<std::size_t>(bytes_required)));
+        shared_hstring_header* header{};
+
+        if (winrt_hstring_pool_enabled)
+        {
+            header = hstring_pool::allocate(bytes_required);
+        }
 
         if (!header)
         {
-            throw std::bad_alloc();
+            header = static_cast<shared_hstring_header*>(WINRT_IMPL_HeapAlloc(WINRT_IMPL_GetProcessHeap(), 0, static_cast<std::size_t>(bytes_required)));
+
+            if (!header)
+            {
+                throw std::bad_alloc();
+            }
         }
 
         header->flags = 0;
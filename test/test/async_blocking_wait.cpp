@@ -0,0 +1,114 @@
+#include "pch.h"
+
+using namespace std::literals;
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    IAsyncOperation<int> Completed(int value)
+    {
+        co_return value;
+    }
+
+    IAsyncOperation<int> Background(int value)
+    {
+        co_await resume_background();
+        co_return value;
+    }
+
+    IAsyncOperation<int> Signaled(int value, handle const& event)
+    {
+        co_await resume_on_signal(event.get());
+        co_return value;
+    }
+
+    // Returns the number of calls per millisecond made by calling the given function the given number of times.
+    template <typename F>
+    int64_t measure(uint32_t const count, F const& call)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            call();
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        return count * 1000ll / (std::max)(elapsed, 1ll);
+    }
+}
+
+TEST_CASE("async_blocking_wait")
+{
+    // Waiting on an operation that completes while the thread is blocked wakes the thread. An async object accepts
+    // only one Completed handler, so each one is waited on only once.
+    handle event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    IAsyncOperation<int> pending = Signaled(123, event);
+    REQUIRE(pending.Status() == AsyncStatus::Started);
+
+    std::thread signal([&]
+    {
+        Sleep(50);
+        SetEvent(event.get());
+    });
+
+    REQUIRE(pending.get() == 123);
+    signal.join();
+
+    // A wait that times out leaves the operation running, and its handler still runs when the operation completes.
+    handle other{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    IAsyncOperation<int> timeout = Signaled(456, other);
+    REQUIRE(timeout.wait_for(10ms) == AsyncStatus::Started);
+    SetEvent(other.get());
+
+    while (timeout.Status() == AsyncStatus::Started)
+    {
+        Sleep(1);
+    }
+
+    REQUIRE(timeout.Status() == AsyncStatus::Completed);
+    REQUIRE(timeout.GetResults() == 456);
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        REQUIRE(Background(index).get() == index);
+    }
+
+    // when_any resumes as soon as the first operation completes, including one that already has.
+    ResetEvent(event.get());
+    REQUIRE(when_any(Signaled(1, event), Completed(2)).get() == 2);
+    REQUIRE(when_any(Completed(1), Completed(2)).get() == 1);
+
+    IAsyncOperation<int> first = when_any(Signaled(1, event), Signaled(2, event));
+    REQUIRE(first.Status() == AsyncStatus::Started);
+
+    signal = std::thread([&]
+    {
+        Sleep(50);
+        SetEvent(event.get());
+    });
+
+    auto const value = first.get();
+    REQUIRE((value == 1 || value == 2));
+    signal.join();
+}
+
+TEST_CASE("async_blocking_wait,benchmark", "[.benchmark]")
+{
+    uint32_t const count = 100'000;
+
+    auto const completed = measure(count, [] { REQUIRE(Completed(1).get() == 1); });
+    auto const background = measure(count, [] { REQUIRE(Background(1).get() == 1); });
+    auto const any = measure(count, [] { REQUIRE(when_any(Completed(1), Completed(2)).get() == 1); });
+
+    // The cost of the kernel event that each blocking wait used to create.
+    auto const events = measure(count, []
+    {
+        handle event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+        SetEvent(event.get());
+        WaitForSingleObject(event.get(), INFINITE);
+    });
+
+    WARN("get: " << completed << " completed/ms, " << background << " background/ms, when_any " << any << "/ms, event alone " << events << "/ms");
+}
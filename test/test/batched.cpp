@@ -0,0 +1,202 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation::Collections;
+
+namespace
+{
+    int64_t sum_batched(param::iterable<int> const& values)
+    {
+        int64_t total{};
+
+        for (auto&& value : batched(static_cast<IIterable<int> const&>(values)))
+        {
+            total += value;
+        }
+
+        return total;
+    }
+
+    int32_t live{};
+
+    struct counted : implements<counted, Windows::Foundation::IStringable>
+    {
+        counted() noexcept
+        {
+            ++live;
+        }
+
+        ~counted() noexcept
+        {
+            --live;
+        }
+
+        hstring ToString()
+        {
+            return L"counted";
+        }
+    };
+
+    // Creates a new object for each element and, like some non-C++/WinRT implementations, writes it into the
+    // caller's slots without releasing what they held.
+    struct generator : implements<generator, IIterable<Windows::Foundation::IStringable>>
+    {
+        struct iterator : implements<iterator, IIterator<Windows::Foundation::IStringable>>
+        {
+            uint32_t m_remaining{};
+
+            explicit iterator(uint32_t const size) noexcept : m_remaining(size)
+            {
+            }
+
+            Windows::Foundation::IStringable Current()
+            {
+                throw hresult_not_implemented();
+            }
+
+            bool HasCurrent()
+            {
+                return m_remaining != 0;
+            }
+
+            bool MoveNext()
+            {
+                throw hresult_not_implemented();
+            }
+
+            uint32_t GetMany(array_view<Windows::Foundation::IStringable> values)
+            {
+                uint32_t const actual = (std::min)(m_remaining, values.size());
+
+                for (uint32_t index = 0; index < actual; ++index)
+                {
+                    reinterpret_cast<void**>(values.data())[index] = detach_abi(make<counted>());
+                }
+
+                m_remaining -= actual;
+                return actual;
+            }
+        };
+
+        uint32_t const m_size;
+
+        explicit generator(uint32_t const size) noexcept : m_size(size)
+        {
+        }
+
+        IIterator<Windows::Foundation::IStringable> First()
+        {
+            return make<iterator>(m_size);
+        }
+    };
+
+    template <typename F>
+    int64_t measure(F const& iterate)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+        REQUIRE(iterate() != 0);
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+TEST_CASE("batched")
+{
+    for (uint32_t size : { 0, 1, 63, 64, 65, 200 })
+    {
+        std::vector<hstring> expected;
+
+        for (uint32_t index = 0; index < size; ++index)
+        {
+            expected.push_back(hstring{ std::to_wstring(index) });
+        }
+
+        IIterable<hstring> iterable = single_threaded_vector<hstring>(std::vector<hstring>(expected));
+        std::vector<hstring> actual;
+
+        for (auto&& value : batched(iterable))
+        {
+            actual.push_back(value);
+        }
+
+        REQUIRE(actual == expected);
+        actual.clear();
+
+        for (auto&& value : batched(iterable, 7))
+        {
+            actual.push_back(value);
+        }
+
+        REQUIRE(actual == expected);
+    }
+
+    std::vector<int> const values{ 1, 2, 3, 4 };
+    REQUIRE(sum_batched(values) == 10);
+    REQUIRE(sum_batched({ 5, 6 }) == 11);
+}
+
+TEST_CASE("batched,release")
+{
+    // Each batch is released before the next one is fetched, so no more than one batch is alive at a time.
+    IIterable<Windows::Foundation::IStringable> iterable = make<generator>(10);
+    uint32_t count{};
+
+    for (auto&& value : batched(iterable, 3))
+    {
+        REQUIRE(value.ToString() == L"counted");
+        REQUIRE(live <= 3);
+        ++count;
+    }
+
+    REQUIRE(count == 10);
+    REQUIRE(live == 0);
+}
+
+TEST_CASE("batched,GetMany")
+{
+    // Trivially copyable elements are copied out of contiguous storage in bulk.
+    IVectorView<int> view = single_threaded_vector<int>({ 1, 2, 3, 4, 5 }).GetView();
+    std::array<int, 4> values{};
+    REQUIRE(view.GetMany(1, values) == 4);
+    REQUIRE(values == std::array<int, 4>{ 2, 3, 4, 5 });
+
+    auto iterator = view.First();
+    REQUIRE(iterator.GetMany(values) == 4);
+    REQUIRE(values == std::array<int, 4>{ 1, 2, 3, 4 });
+    REQUIRE(iterator.GetMany(values) == 1);
+    REQUIRE(values[0] == 5);
+}
+
+TEST_CASE("batched,benchmark", "[.benchmark]")
+{
+    for (uint32_t size : { 1'000, 10'000, 100'000, 1'000'000 })
+    {
+        std::vector<int> values(size, 1);
+        IIterable<int> iterable = single_threaded_vector<int>(std::move(values));
+
+        auto const each = measure([&]
+        {
+            int64_t total{};
+
+            for (auto iterator = iterable.First(); iterator.HasCurrent(); iterator.MoveNext())
+            {
+                total += iterator.Current();
+            }
+
+            return total;
+        });
+
+        auto const batch = measure([&]
+        {
+            int64_t total{};
+
+            for (auto&& value : batched(iterable))
+            {
+                total += value;
+            }
+
+            return total;
+        });
+
+        WARN(size << " elements: per element " << each << "us, batched " << batch << "us");
+    }
+}
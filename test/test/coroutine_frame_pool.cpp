@@ -0,0 +1,144 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    struct pool_guard
+    {
+        pool_guard() noexcept
+        {
+            winrt_coroutine_frame_pool_enabled = true;
+        }
+
+        ~pool_guard() noexcept
+        {
+            winrt_coroutine_frame_pool_enabled = false;
+        }
+    };
+
+    std::vector<std::pair<void*, uint32_t>> frames;
+
+    void __stdcall record_frame(void* address, uint32_t size) noexcept
+    {
+        frames.emplace_back(address, size);
+    }
+
+    IAsyncAction Action()
+    {
+        co_return;
+    }
+
+    IAsyncOperation<int> Operation(int value)
+    {
+        co_return value;
+    }
+
+    IAsyncOperation<hstring> LargeOperation()
+    {
+        std::array<wchar_t, 1024> buffer{};
+        co_await resume_background();
+        buffer[0] = L'x';
+        co_return hstring{ buffer.data(), 1 };
+    }
+
+    int64_t run_actions(uint32_t const count)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            Action().get();
+        }
+
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+TEST_CASE("coroutine_frame_pool")
+{
+    pool_guard guard;
+    void* first{};
+
+    {
+        IAsyncAction action = Action();
+        first = get_abi(action);
+        action.get();
+    }
+
+    // A frame destroyed on this thread is reused by the next coroutine of the same size class.
+    IAsyncAction action = Action();
+    REQUIRE(get_abi(action) == first);
+    action.get();
+
+    REQUIRE(Operation(123).get() == 123);
+
+    // Larger frames use a larger size class, and may complete on another thread.
+    REQUIRE(LargeOperation().get() == L"x");
+}
+
+TEST_CASE("coroutine_frame_pool,disabled")
+{
+    pool_guard guard;
+    void* cached{};
+
+    {
+        IAsyncAction action = Action();
+        cached = get_abi(action);
+        action.get();
+    }
+
+    // Frames allocated while the pool is disabled come from the heap rather than the cache.
+    winrt_coroutine_frame_pool_enabled = false;
+    IAsyncAction action = Action();
+    void* const unpooled = get_abi(action);
+    REQUIRE(unpooled != cached);
+    action.get();
+
+    // Such a frame goes back to the heap even if the pool has been enabled by then, so the next coroutine of the same
+    // size class still gets the frame that was cached before.
+    winrt_coroutine_frame_pool_enabled = true;
+    action = nullptr;
+    action = Action();
+    REQUIRE(get_abi(action) == cached);
+    action.get();
+}
+
+TEST_CASE("coroutine_frame_pool,handler")
+{
+    frames.clear();
+    winrt_coroutine_frame_handler = record_frame;
+
+    Action().get();
+    Action().get();
+    REQUIRE(Operation(1).get() == 1);
+
+    winrt_coroutine_frame_handler = nullptr;
+
+    // The handler is given the same address for each start of the same coroutine, along with its frame size.
+    REQUIRE(frames.size() == 3);
+    REQUIRE(frames[0] == frames[1]);
+    REQUIRE(frames[0].first != frames[2].first);
+    REQUIRE(frames[0].second > 0);
+}
+
+TEST_CASE("coroutine_frame_pool,benchmark", "[.benchmark]")
+{
+    frames.clear();
+    winrt_coroutine_frame_handler = record_frame;
+    Action().get();
+    Operation(1).get();
+    LargeOperation().get();
+    winrt_coroutine_frame_handler = nullptr;
+
+    for (auto&& [address, size] : frames)
+    {
+        WARN("coroutine at " << address << ": " << size << " byte frame");
+    }
+
+    auto const heap = run_actions(1'000'000);
+    pool_guard guard;
+    auto const pool = run_actions(1'000'000);
+    WARN("1000000 actions: heap " << heap << "ms, pool " << pool << "ms");
+}
@@ -243,6 +243,27 @@ TEST_CASE("disconnected,action")
     REQUIRE_THROWS_MATCHES(result.get(), hresult_error, holds_hresult(RPC_E_DISCONNECTED));
 }
 
+TEST_CASE("disconnected,when_all")
+{
+    auto private_context = create_instance<IContextCallback>(CLSID_ContextSwitcher);
+    handle signal{ CreateEventW(nullptr, true, false, nullptr) };
+    disconnect_on_signal(private_context, signal.get());
+
+    agile_ref<IAsyncAction> action;
+    InvokeInContext(private_context.get(), [&]()
+        {
+            action = make<non_agile_abandoned_action>([&]{ SetEvent(signal.get()); });
+        });
+
+    // The disconnected action's handler is destroyed without being called, which must still resume when_all.
+    auto result = [](IAsyncAction action) -> IAsyncAction
+        {
+            co_await when_all(Action(), action);
+        }(action.get());
+
+    REQUIRE_THROWS_MATCHES(result.get(), hresult_error, holds_hresult(RPC_E_DISCONNECTED));
+}
+
 #if defined(__clang__) && (defined(_M_IX86) || defined(__i386__))
 // FIXME: Test is known to crash with exit code 0xc000070a on x86 when built with Clang.
 TEST_CASE("disconnected,double", "[.clang-crash]")
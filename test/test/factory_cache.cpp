@@ -0,0 +1,156 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    struct stringable_factory : implements<stringable_factory, IActivationFactory, IStringable>
+    {
+        IInspectable ActivateInstance()
+        {
+            return nullptr;
+        }
+
+        hstring ToString()
+        {
+            return L"stringable_factory";
+        }
+    };
+
+    std::atomic<uint32_t> activations{};
+
+    int32_t __stdcall handler(void* classId, guid const& iid, void** factory) noexcept
+    {
+        ++activations;
+
+        if (reinterpret_cast<hstring const&>(classId) == L"Test.Missing")
+        {
+            return static_cast<int32_t>(0x80040154); // REGDB_E_CLASSNOTREG
+        }
+
+        return make<stringable_factory>().as(iid, factory);
+    }
+
+    // Returns the average time in nanoseconds taken by each activation when the given number of threads each
+    // activate a set of classes by name the given number of times.
+    int64_t measure_activation(uint32_t const threads, uint32_t const rounds)
+    {
+        uint32_t const classes = 64;
+        std::vector<hstring> names;
+
+        for (uint32_t index = 0; index < classes; ++index)
+        {
+            names.push_back(hstring{ L"Test.Class" + std::to_wstring(index) });
+        }
+
+        std::atomic<bool> start{};
+        std::atomic<uint32_t> failures{};
+        std::vector<std::thread> activators;
+
+        for (uint32_t thread = 0; thread < threads; ++thread)
+        {
+            activators.emplace_back([&]
+            {
+                while (!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                for (uint32_t round = 0; round < rounds; ++round)
+                {
+                    for (auto&& name : names)
+                    {
+                        if (!get_cached_activation_factory(name))
+                        {
+                            ++failures;
+                        }
+                    }
+                }
+            });
+        }
+
+        auto const begin = std::chrono::high_resolution_clock::now();
+        start = true;
+
+        for (auto&& activator : activators)
+        {
+            activator.join();
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - begin).count();
+        REQUIRE(failures == 0);
+        return elapsed / (threads * classes * rounds);
+    }
+}
+
+TEST_CASE("factory_cache")
+{
+    clear_factory_cache();
+    REQUIRE(!winrt_activation_handler);
+    winrt_activation_handler = handler;
+    activations = 0;
+
+    auto const before = get_factory_cache_statistics();
+
+    // Classes that cannot be activated are skipped.
+    REQUIRE(preload_factory_cache({ L"Test.First", L"Test.Second", L"Test.Missing" }) == 2);
+    REQUIRE(activations == 3);
+
+    auto const preloaded = get_factory_cache_statistics();
+    REQUIRE(preloaded.misses - before.misses == 3);
+
+    // Preloaded factories are served from the cache, including their other factory interfaces.
+    auto first = get_cached_activation_factory(L"Test.First");
+    REQUIRE(first == get_cached_activation_factory(L"Test.First"));
+    REQUIRE(get_cached_activation_factory<IStringable>(L"Test.Second").ToString() == L"stringable_factory");
+    REQUIRE(activations == 3);
+
+    auto const warm = get_factory_cache_statistics();
+    REQUIRE(warm.hits - preloaded.hits == 3);
+    REQUIRE(warm.misses == preloaded.misses);
+
+    REQUIRE_THROWS_AS(get_cached_activation_factory(L"Test.Missing"), hresult_class_not_registered);
+    REQUIRE(activations == 4);
+
+    // get_activation_factory doesn't use the cache, so it always goes through the current activation handler.
+    auto uncached = get_activation_factory(L"Test.First");
+    REQUIRE(uncached != first);
+    REQUIRE(uncached != get_activation_factory(L"Test.First"));
+    REQUIRE(activations == 6);
+
+    auto const uncached_statistics = get_factory_cache_statistics();
+    REQUIRE(uncached_statistics.hits == warm.hits);
+    REQUIRE(uncached_statistics.misses - warm.misses == 1);
+
+    // Clearing the cache releases the factories, so they are activated again on next use.
+    clear_factory_cache();
+    REQUIRE(first != get_cached_activation_factory(L"Test.First"));
+    REQUIRE(activations == 7);
+
+    winrt_activation_handler = nullptr;
+    clear_factory_cache();
+}
+
+TEST_CASE("factory_cache,benchmark", "[.benchmark]")
+{
+    clear_factory_cache();
+    winrt_activation_handler = handler;
+
+    for (uint32_t threads = 1; threads <= (std::max)(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        clear_factory_cache();
+        auto const before = get_factory_cache_statistics();
+        auto const cold = measure_activation(threads, 1);
+        auto const warm = measure_activation(threads, 100);
+        auto const after = get_factory_cache_statistics();
+
+        WARN(threads << " threads: cold " << cold << "ns, warm " << warm << "ns per activation ("
+            << after.hits - before.hits << " hits, "
+            << after.misses - before.misses << " misses, "
+            << after.contention - before.contention << " contended)");
+    }
+
+    winrt_activation_handler = nullptr;
+    clear_factory_cache();
+}
@@ -0,0 +1,71 @@
+#include "pch.h"
+
+using namespace winrt;
+
+namespace
+{
+    template <typename F>
+    int64_t measure(F const& hash, std::vector<std::wstring> const& keys, uint32_t const count)
+    {
+        size_t total{};
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            auto&& key = keys[index % keys.size()];
+            total += hash(key.data(), key.size() * sizeof(wchar_t));
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        REQUIRE(total != 1);
+        return elapsed;
+    }
+}
+
+TEST_CASE("fast_hash")
+{
+    std::vector<uint8_t> buffer(256);
+
+    for (size_t index = 0; index < buffer.size(); ++index)
+    {
+        buffer[index] = static_cast<uint8_t>(index * 7 + 3);
+    }
+
+    std::set<uint64_t> hashes;
+
+    // Every length up to several blocks takes a different path through the block, word and byte loops, and
+    // each must produce a distinct and repeatable result.
+    for (size_t length = 0; length <= 100; ++length)
+    {
+        auto const hash = impl::hash_data_fast(buffer.data(), length);
+        REQUIRE(hash == impl::hash_data_fast(buffer.data(), length));
+        REQUIRE(hashes.insert(hash).second);
+
+        // The result doesn't depend on alignment.
+        std::vector<uint8_t> copy(length + 1);
+        std::copy_n(buffer.begin(), length, copy.begin() + 1);
+        REQUIRE(hash == impl::hash_data_fast(copy.data() + 1, length));
+    }
+
+    // A single bit difference changes the result.
+    auto const hash = impl::hash_data_fast(buffer.data(), 64);
+    buffer[40] ^= 1;
+    REQUIRE(hash != impl::hash_data_fast(buffer.data(), 64));
+}
+
+TEST_CASE("fast_hash,benchmark", "[.benchmark]")
+{
+    for (size_t length : { 4, 8, 16, 32, 64, 128, 256 })
+    {
+        std::vector<std::wstring> keys;
+
+        for (wchar_t index = 0; index < 64; ++index)
+        {
+            keys.emplace_back(length, static_cast<wchar_t>(L'A' + index));
+        }
+
+        auto const fnv = measure([](void const* data, size_t bytes) { return impl::hash_data(data, bytes); }, keys, 10'000'000);
+        auto const fast = measure([](void const* data, size_t bytes) { return static_cast<size_t>(impl::hash_data_fast(data, bytes)); }, keys, 10'000'000);
+        WARN(length << " chars: fnv " << fnv << "ms, fast " << fast << "ms");
+    }
+}
@@ -0,0 +1,106 @@
+#include "pch.h"
+
+using namespace winrt;
+
+namespace
+{
+    struct pool_guard
+    {
+        pool_guard() noexcept
+        {
+            winrt_hstring_pool_enabled = true;
+        }
+
+        ~pool_guard() noexcept
+        {
+            winrt_hstring_pool_enabled = false;
+        }
+    };
+
+    int64_t create_strings(uint32_t const count)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            hstring value{ L"PropertyName" };
+            REQUIRE(value.size() == 12);
+        }
+
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+TEST_CASE("hstring_pool")
+{
+    pool_guard guard;
+    void* first{};
+
+    {
+        hstring value{ L"key" };
+        first = get_abi(value);
+        REQUIRE(value == L"key");
+    }
+
+    // A small string released on this thread is reused for the next string of the same size class.
+    hstring value{ L"other" };
+    REQUIRE(get_abi(value) == first);
+    REQUIRE(value == L"other");
+
+    // Copies share the same block, which is only returned to the pool once the last one is released.
+    hstring copy = value;
+    REQUIRE(get_abi(copy) == first);
+    value = L"";
+    REQUIRE(copy == L"other");
+
+    // Strings larger than the largest size class come from the heap as before.
+    std::wstring const large(1000, L'x');
+    hstring big{ large };
+    REQUIRE(big == large);
+}
+
+TEST_CASE("hstring_pool,abi")
+{
+    pool_guard guard;
+
+    // Pooled strings are still process heap allocations, so they may be freed by WindowsDeleteString.
+    hstring value{ L"abi" };
+    REQUIRE(S_OK == WindowsDeleteString(static_cast<HSTRING>(detach_abi(value))));
+
+    // Strings created by the OS are process heap blocks too, and join the largest size class their heap size can hold.
+    std::wstring const text(60, L'o');
+    HSTRING raw{};
+    REQUIRE(S_OK == WindowsCreateString(text.c_str(), static_cast<uint32_t>(text.size()), &raw));
+    size_t const size = HeapSize(GetProcessHeap(), 0, raw);
+    uint32_t index = impl::hstring_pool::class_count;
+
+    for (uint32_t candidate = 0; candidate < impl::hstring_pool::class_count; ++candidate)
+    {
+        if (size >= impl::hstring_pool::class_size(candidate))
+        {
+            index = candidate;
+        }
+    }
+
+    REQUIRE(index < impl::hstring_pool::class_count);
+    hstring attached{ raw, take_ownership_from_abi };
+    REQUIRE(attached == text);
+    attached = L"";
+
+    // The next string of that size class reuses the block.
+    hstring reused{ std::wstring((impl::hstring_pool::class_size(index) - sizeof(impl::shared_hstring_header)) / sizeof(wchar_t), L'r') };
+    REQUIRE(get_abi(reused) == raw);
+
+    // Pooled strings may also be released after the pool has been turned off.
+    hstring pooled{ L"pooled" };
+    winrt_hstring_pool_enabled = false;
+    pooled = L"";
+}
+
+TEST_CASE("hstring_pool,benchmark", "[.benchmark]")
+{
+    auto const heap = create_strings(10'000'000);
+    pool_guard guard;
+    auto const pooled = create_strings(10'000'000);
+    WARN("heap: " << heap << "ms, pool: " << pooled << "ms");
+}
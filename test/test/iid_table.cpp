@@ -0,0 +1,111 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+using namespace Windows::Foundation::Collections;
+
+namespace
+{
+    struct Wide : implements<Wide,
+        IClosable,
+        IStringable,
+        IWwwFormUrlDecoderEntry,
+        IUriEscapeStatics,
+        IGetActivationFactory,
+        IMemoryBuffer,
+        IDeferralFactory,
+        IUriRuntimeClassFactory,
+        IVectorChangedEventArgs>
+    {
+        void Close() {}
+        hstring ToString() { return L"Wide"; }
+        hstring Name() { return L"Name"; }
+        hstring Value() { return L"Value"; }
+        hstring UnescapeComponent(hstring const& value) { return value; }
+        hstring EscapeComponent(hstring const& value) { return value; }
+        IInspectable GetActivationFactory(hstring const&) { return nullptr; }
+        IMemoryBufferReference CreateReference() { return nullptr; }
+        Deferral Create(DeferralCompletedHandler const&) { return nullptr; }
+        Uri CreateUri(hstring const&) { return nullptr; }
+        Uri CreateWithRelativeUri(hstring const&, hstring const&) { return nullptr; }
+        Collections::CollectionChange CollectionChange() { return Collections::CollectionChange::Reset; }
+        uint32_t Index() { return 123; }
+    };
+
+    template <typename T>
+    void* find_linear(T const* object, guid const& id) noexcept
+    {
+        return impl::implemented_interfaces<T>::find(impl::find_iid_traits<T>{ object, id });
+    }
+
+    template <typename T, typename F>
+    int64_t measure(T const* object, guid const& id, F const& find)
+    {
+        uintptr_t total{};
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t count = 0; count < 10'000'000; ++count)
+        {
+            total += reinterpret_cast<uintptr_t>(find(object, id));
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        REQUIRE(total != 1);
+        return elapsed;
+    }
+}
+
+TEST_CASE("iid_table")
+{
+    static_assert(impl::interface_count<impl::implemented_interfaces<Wide>>::value >= impl::iid_table_threshold);
+
+    auto object = make_self<Wide>();
+    IInspectable inspectable = object.as<IInspectable>();
+
+    REQUIRE(inspectable.as<IStringable>().ToString() == L"Wide");
+    REQUIRE(inspectable.as<IWwwFormUrlDecoderEntry>().Value() == L"Value");
+    REQUIRE(inspectable.as<IVectorChangedEventArgs>().Index() == 123);
+    REQUIRE(inspectable.try_as<IClosable>());
+    REQUIRE(inspectable.try_as<IUriRuntimeClassFactory>());
+    REQUIRE(!inspectable.try_as<IAsyncAction>());
+    REQUIRE(!inspectable.try_as<IVectorView<int>>());
+
+    // The table finds exactly what the linear search finds.
+    for (auto&& id : impl::uncloaked_iids<impl::uncloaked_interfaces<Wide>>::value)
+    {
+        REQUIRE(impl::find_iid(object.get(), id) != nullptr);
+        REQUIRE(impl::find_iid(object.get(), id) == find_linear(object.get(), id));
+    }
+
+    REQUIRE(impl::find_iid(object.get(), guid_of<IAsyncAction>()) == nullptr);
+
+    // The convertible observable vector implements eight interfaces as well.
+    IObservableVector<int> vector = single_threaded_observable_vector<int>();
+    REQUIRE(vector.try_as<IVectorView<int>>());
+    REQUIRE(vector.try_as<IIterable<IInspectable>>());
+    REQUIRE(!vector.try_as<IVectorView<hstring>>());
+}
+
+TEST_CASE("iid_table,benchmark", "[.benchmark]")
+{
+    auto object = make_self<Wide>();
+
+    for (auto&& [name, id] : { std::pair{ "first", guid_of<IClosable>() }, std::pair{ "last", guid_of<IVectorChangedEventArgs>() }, std::pair{ "missing", guid_of<IAsyncAction>() } })
+    {
+        auto const linear = measure(object.get(), id, [](auto object, guid const& id) { return find_linear(object, id); });
+        auto const table = measure(object.get(), id, [](auto object, guid const& id) { return impl::find_iid(object, id); });
+        WARN(name << ": linear " << linear << "ms, table " << table << "ms");
+    }
+
+    IInspectable inspectable = object.as<IInspectable>();
+    void* result{};
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t count = 0; count < 10'000'000; ++count)
+    {
+        REQUIRE(S_OK == static_cast<::IUnknown*>(get_abi(inspectable))->QueryInterface(guid_of<IVectorChangedEventArgs>(), &result));
+        static_cast<::IUnknown*>(result)->Release();
+    }
+
+    WARN("QueryInterface: " << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count() << "ms");
+}
@@ -0,0 +1,159 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    // Returns the number of invocations per millisecond made by the given number of threads while another thread
+    // keeps adding and removing a handler.
+    template <typename Event>
+    uint64_t measure_invoke(uint32_t const threads)
+    {
+        Event source;
+        std::atomic<uint64_t> total{};
+
+        for (int index = 0; index < 4; ++index)
+        {
+            source.add([&](auto&&...) { total.fetch_add(1, std::memory_order_relaxed); });
+        }
+
+        std::atomic<bool> start{};
+        std::atomic<bool> stop{};
+        std::vector<std::thread> invokers;
+
+        for (uint32_t thread = 0; thread < threads; ++thread)
+        {
+            invokers.emplace_back([&]
+            {
+                while (!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                while (!stop)
+                {
+                    source(0, 0);
+                }
+            });
+        }
+
+        start = true;
+        auto const until = std::chrono::steady_clock::now() + std::chrono::milliseconds(250);
+
+        while (std::chrono::steady_clock::now() < until)
+        {
+            source.remove(source.add([](auto&&...) {}));
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        stop = true;
+
+        for (auto&& invoker : invokers)
+        {
+            invoker.join();
+        }
+
+        return total / 4 / 250;
+    }
+}
+
+TEST_CASE("lock_free_event")
+{
+    lock_free_event<TypedEventHandler<int, int>> event;
+    REQUIRE(!event);
+    int counter{};
+
+    auto a = event.add([&](auto&&...)
+        {
+            counter += 1;
+        });
+
+    event.add([&](auto&&...)
+        {
+            counter += 10;
+        });
+
+    REQUIRE(event);
+    event(0, 0);
+    REQUIRE(counter == 11);
+
+    event.remove(a);
+    event(0, 0);
+    REQUIRE(counter == 21);
+
+    // A handler can remove itself while the event is being raised.
+    event_token self{};
+    self = event.add([&](auto&&...)
+        {
+            counter += 100;
+            event.remove(self);
+        });
+
+    event(0, 0);
+    event(0, 0);
+    REQUIRE(counter == 141);
+
+    event.clear();
+    REQUIRE(!event);
+    event(0, 0);
+    REQUIRE(counter == 141);
+}
+
+TEST_CASE("lock_free_event,release")
+{
+    // Without a concurrent invocation a removed handler is released right away, just as it is by event.
+    lock_free_event<TypedEventHandler<int, int>> event;
+    auto released = std::make_shared<int>();
+    std::weak_ptr<int> weak = released;
+    auto token = event.add([released = std::move(released)](auto&&...) {});
+
+    REQUIRE(!weak.expired());
+    event.remove(token);
+    REQUIRE(weak.expired());
+}
+
+TEST_CASE("lock_free_event,concurrent")
+{
+    lock_free_event<TypedEventHandler<int, int>> event;
+    std::atomic<uint32_t> counter{};
+    event.add([&](auto&&...) { ++counter; });
+
+    std::atomic<bool> stop{};
+    std::vector<std::thread> invokers;
+
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        invokers.emplace_back([&]
+        {
+            while (!stop)
+            {
+                event(0, 0);
+            }
+        });
+    }
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        event.remove(event.add([](auto&&...) {}));
+    }
+
+    stop = true;
+
+    for (auto&& invoker : invokers)
+    {
+        invoker.join();
+    }
+
+    REQUIRE(counter > 0);
+}
+
+TEST_CASE("lock_free_event,benchmark", "[.benchmark]")
+{
+    for (uint32_t threads = 1; threads <= (std::max)(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        auto const locked = measure_invoke<event<TypedEventHandler<int, int>>>(threads);
+        auto const lock_free = measure_invoke<lock_free_event<TypedEventHandler<int, int>>>(threads);
+        WARN(threads << " threads: event " << locked << " invokes/ms, lock_free_event " << lock_free << " invokes/ms");
+    }
+}
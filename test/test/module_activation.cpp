@@ -0,0 +1,140 @@
+#include "pch.h"
+
+// The generated <lib>_get_activation_factory function first switches on the length of the requested class name and
+// then compares it with the names of that length, each compared from the end since names in a component share
+// their namespace prefixes. These tests reproduce both that shape and the linear chain of comparisons that it
+// replaced, for components of different sizes.
+
+namespace
+{
+    bool requal(std::wstring_view const& left, std::wstring_view const& right) noexcept
+    {
+        return std::equal(left.rbegin(), left.rend(), right.rbegin(), right.rend());
+    }
+
+    std::vector<std::wstring> make_names(uint32_t const count)
+    {
+        static wchar_t const* const namespaces[]{ L"Contoso", L"Contoso.Controls", L"Contoso.Controls.Primitives" };
+        static wchar_t const* const kinds[]{ L"Button", L"ListViewItem", L"Presenter", L"AutomationPeer", L"Converter" };
+        std::vector<std::wstring> names;
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            names.push_back(std::wstring(namespaces[index % std::size(namespaces)]) + L"." + kinds[index % std::size(kinds)] + std::to_wstring(index));
+        }
+
+        return names;
+    }
+
+    struct linear_dispatch
+    {
+        explicit linear_dispatch(std::vector<std::wstring> const& names) : m_names(names)
+        {
+        }
+
+        int32_t find(std::wstring_view const& name) const noexcept
+        {
+            for (size_t index = 0; index < m_names.size(); ++index)
+            {
+                if (requal(name, m_names[index]))
+                {
+                    return static_cast<int32_t>(index);
+                }
+            }
+
+            return -1;
+        }
+
+    private:
+
+        std::vector<std::wstring> const& m_names;
+    };
+
+    struct length_dispatch
+    {
+        explicit length_dispatch(std::vector<std::wstring> const& names)
+        {
+            for (size_t index = 0; index < names.size(); ++index)
+            {
+                if (m_buckets.size() <= names[index].size())
+                {
+                    m_buckets.resize(names[index].size() + 1);
+                }
+
+                m_buckets[names[index].size()].emplace_back(names[index], static_cast<int32_t>(index));
+            }
+        }
+
+        int32_t find(std::wstring_view const& name) const noexcept
+        {
+            if (name.size() >= m_buckets.size())
+            {
+                return -1;
+            }
+
+            for (auto&& [candidate, index] : m_buckets[name.size()])
+            {
+                if (requal(name, candidate))
+                {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+
+    private:
+
+        std::vector<std::vector<std::pair<std::wstring_view, int32_t>>> m_buckets;
+    };
+
+    template <typename Dispatch>
+    int64_t measure(std::vector<std::wstring> const& names)
+    {
+        Dispatch const dispatch(names);
+        uint32_t const rounds = 1'000'000 / static_cast<uint32_t>(names.size());
+        int64_t total{};
+
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t round = 0; round < rounds; ++round)
+        {
+            for (auto&& name : names)
+            {
+                total += dispatch.find(name);
+            }
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        REQUIRE(total > 0);
+        return elapsed / (rounds * static_cast<int64_t>(names.size()));
+    }
+}
+
+TEST_CASE("module_activation")
+{
+    auto const names = make_names(100);
+    linear_dispatch const linear(names);
+    length_dispatch const bucketed(names);
+
+    for (size_t index = 0; index < names.size(); ++index)
+    {
+        REQUIRE(linear.find(names[index]) == static_cast<int32_t>(index));
+        REQUIRE(bucketed.find(names[index]) == static_cast<int32_t>(index));
+    }
+
+    REQUIRE(bucketed.find(L"Contoso.Missing") == -1);
+    REQUIRE(bucketed.find(L"") == -1);
+    REQUIRE(bucketed.find(std::wstring(1000, L'x')) == -1);
+}
+
+TEST_CASE("module_activation,benchmark", "[.benchmark]")
+{
+    for (uint32_t count : { 10, 100, 1000 })
+    {
+        auto const names = make_names(count);
+        auto const linear = measure<linear_dispatch>(names);
+        auto const bucketed = measure<length_dispatch>(names);
+        WARN(count << " classes: linear " << linear << "ns, by length " << bucketed << "ns per activation");
+    }
+}
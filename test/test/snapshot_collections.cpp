@@ -0,0 +1,211 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation::Collections;
+
+namespace
+{
+    // Returns the number of GetAt calls made per millisecond by the given number of reader threads.
+    uint64_t measure_reads(IVector<int> const& vector, uint32_t const threads)
+    {
+        std::atomic<bool> start{};
+        std::atomic<bool> stop{};
+        std::atomic<uint64_t> total{};
+        std::vector<std::thread> readers;
+
+        for (uint32_t thread = 0; thread < threads; ++thread)
+        {
+            readers.emplace_back([&]
+            {
+                while (!start)
+                {
+                    std::this_thread::yield();
+                }
+
+                uint64_t count{};
+
+                while (!stop)
+                {
+                    for (uint32_t index = 0; index < 1000; ++index)
+                    {
+                        count += vector.GetAt(index % 64) >= 0;
+                    }
+                }
+
+                total += count;
+            });
+        }
+
+        start = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        stop = true;
+
+        for (auto&& reader : readers)
+        {
+            reader.join();
+        }
+
+        return total / 250;
+    }
+}
+
+TEST_CASE("snapshot_collections,vector")
+{
+    IVector<int> vector = snapshot_vector<int>({ 1, 2, 3 });
+    REQUIRE(vector.Size() == 3);
+
+    vector.Append(4);
+    vector.InsertAt(0, 0);
+    vector.RemoveAt(1);
+    vector.SetAt(0, 9);
+    REQUIRE(vector.Size() == 4);
+    REQUIRE(vector.GetAt(0) == 9);
+    REQUIRE(vector.GetAt(3) == 4);
+
+    uint32_t index{};
+    REQUIRE(vector.IndexOf(3, index));
+    REQUIRE(index == 2);
+
+    // A failed change leaves the published snapshot untouched.
+    REQUIRE_THROWS_AS(vector.InsertAt(10, 1), hresult_out_of_bounds);
+    REQUIRE(vector.Size() == 4);
+
+    // Iterators are invalidated by a change just as they are for the other vectors.
+    auto iterator = vector.First();
+    vector.Append(5);
+    REQUIRE_THROWS_AS(iterator.Current(), hresult_changed_state);
+
+    std::vector<int> values;
+
+    for (auto&& value : vector)
+    {
+        values.push_back(value);
+    }
+
+    REQUIRE(values == std::vector<int>{ 9, 2, 3, 4, 5 });
+
+    vector.ReplaceAll({ 7, 8 });
+    REQUIRE(vector.Size() == 2);
+    vector.Clear();
+    REQUIRE(vector.Size() == 0);
+}
+
+TEST_CASE("snapshot_collections,map")
+{
+    IMap<int, int> map = snapshot_map<int, int>();
+    REQUIRE(!map.Insert(1, 10));
+    REQUIRE(!map.Insert(2, 20));
+    REQUIRE(map.Insert(2, 30));
+    REQUIRE(map.Lookup(2) == 30);
+    REQUIRE(map.HasKey(1));
+
+    map.Remove(1);
+    REQUIRE(!map.HasKey(1));
+    REQUIRE_THROWS_AS(map.Remove(1), hresult_out_of_bounds);
+    REQUIRE(map.Size() == 1);
+
+    IMap<int, int> unordered = snapshot_map<int, int>(std::unordered_map<int, int>{ { 1, 1 } });
+    REQUIRE(unordered.Lookup(1) == 1);
+}
+
+TEST_CASE("snapshot_collections,iterator")
+{
+    // A writer bumps the version before it publishes, so an iterator created in between records the new version but
+    // refers to the old snapshot. It must keep that snapshot alive once the writer has replaced it.
+    auto vector = make_self<impl::snapshot_vector<hstring, std::vector<hstring>>>(std::vector<hstring>{ L"one", L"two" });
+    IIterator<hstring> iterator;
+
+    {
+        [[maybe_unused]] auto guard = vector->acquire_exclusive();
+        vector->increment_version();
+        vector->get_container().push_back(L"three");
+        iterator = vector->First();
+    }
+
+    REQUIRE(vector->Size() == 3);
+    REQUIRE(iterator.Current() == L"one");
+    REQUIRE(iterator.MoveNext());
+    REQUIRE(iterator.Current() == L"two");
+    REQUIRE(!iterator.MoveNext());
+
+    vector->Append(L"four");
+    REQUIRE_THROWS_AS(iterator.Current(), hresult_changed_state);
+
+    // An iterator shared between threads advances one element at a time.
+    IVector<int> values = snapshot_vector<int>(std::vector<int>(1000));
+    IIterator<int> shared = values.First();
+    std::atomic<uint32_t> moved{};
+    std::vector<std::thread> threads;
+
+    for (uint32_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&]
+        {
+            while (shared.MoveNext())
+            {
+                ++moved;
+            }
+        });
+    }
+
+    for (auto&& thread : threads)
+    {
+        thread.join();
+    }
+
+    REQUIRE(moved == 999);
+}
+
+TEST_CASE("snapshot_collections,concurrent")
+{
+    // The writer keeps every element equal, so any reader that sees a mix of values read a torn snapshot.
+    IVector<int> vector = snapshot_vector<int>(std::vector<int>(64));
+    std::atomic<bool> stop{};
+    std::atomic<uint32_t> torn{};
+    std::vector<std::thread> readers;
+
+    for (uint32_t thread = 0; thread < 4; ++thread)
+    {
+        readers.emplace_back([&]
+        {
+            std::array<int, 64> values{};
+
+            while (!stop)
+            {
+                uint32_t const count = vector.GetMany(0, values);
+
+                if (count != values.size() || std::count(values.begin(), values.end(), values[0]) != static_cast<ptrdiff_t>(count))
+                {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    for (int value = 1; value < 1000; ++value)
+    {
+        vector.ReplaceAll(std::vector<int>(64, value));
+    }
+
+    stop = true;
+
+    for (auto&& reader : readers)
+    {
+        reader.join();
+    }
+
+    REQUIRE(torn == 0);
+}
+
+TEST_CASE("snapshot_collections,benchmark", "[.benchmark]")
+{
+    IVector<int> shared = multi_threaded_vector<int>(std::vector<int>(64, 1));
+    IVector<int> snapshot = snapshot_vector<int>(std::vector<int>(64, 1));
+
+    for (uint32_t threads = 1; threads <= (std::max)(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        auto const locked = measure_reads(shared, threads);
+        auto const lock_free = measure_reads(snapshot, threads);
+        WARN(threads << " threads: multi_threaded_vector " << locked << " reads/ms, snapshot_vector " << lock_free << " reads/ms");
+    }
+}
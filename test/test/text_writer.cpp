@@ -0,0 +1,163 @@
+#include "pch.h"
+#include "text_writer.h"
+
+using namespace cppwinrt;
+
+namespace
+{
+    struct test_writer : writer_base<test_writer>
+    {
+        using writer_base<test_writer>::write;
+    };
+
+    // True when the format has exactly Count placeholders. A mismatch fails to compile wherever such a format is
+    // passed to writer_base::write, so it can only be detected in a context that tolerates substitution failure.
+    template <size_t Count, auto const& Format>
+    constexpr bool is_valid_format = requires { typename std::integral_constant<bool, (format_string<Count>(Format), true)>; };
+
+    static constexpr char two_placeholders[] = "% and @";
+    static constexpr char escaped_placeholder[] = "^% and %";
+
+    std::string segments_of(chunked_buffer const& buffer, std::vector<size_t>& sizes)
+    {
+        std::string result;
+
+        buffer.each_segment([&](std::string_view const& segment)
+        {
+            sizes.push_back(segment.size());
+            result.append(segment);
+            return true;
+        });
+
+        return result;
+    }
+
+    struct temp_directory
+    {
+        std::filesystem::path path{ std::filesystem::temp_directory_path() / "cppwinrt_text_writer" };
+
+        temp_directory()
+        {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+        }
+
+        ~temp_directory()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(path, ignored);
+        }
+    };
+}
+
+TEST_CASE("text_writer,chunked_buffer")
+{
+    size_t const chunk = chunked_buffer::chunk_size;
+    chunked_buffer buffer;
+    REQUIRE(buffer.empty());
+
+    // Exactly one chunk, then text that spans the boundary into a second and third chunk.
+    std::string expected(chunk, 'a');
+    buffer.append(expected);
+    REQUIRE(buffer.size() == chunk);
+    REQUIRE(buffer.back() == 'a');
+
+    std::string const spanning = std::string(chunk + 10, 'b') + 'c';
+    buffer.append(spanning);
+    expected += spanning;
+    buffer.push_back('d');
+    expected += 'd';
+    REQUIRE(buffer.size() == expected.size());
+    REQUIRE(buffer.back() == 'd');
+
+    std::vector<size_t> sizes;
+    REQUIRE(segments_of(buffer, sizes) == expected);
+    REQUIRE(sizes == std::vector<size_t>{ chunk, chunk, 12 });
+
+    std::string copy;
+    buffer.copy(chunk - 1, copy);
+    REQUIRE(copy == expected.substr(chunk - 1));
+
+    // Truncating back across a boundary releases the chunks beyond it and appending continues from there.
+    buffer.truncate(chunk + 1);
+    REQUIRE(buffer.back() == 'b');
+    buffer.append("xyz");
+    expected = expected.substr(0, chunk + 1) + "xyz";
+    sizes.clear();
+    REQUIRE(segments_of(buffer, sizes) == expected);
+    REQUIRE(sizes == std::vector<size_t>{ chunk, 4 });
+
+    buffer.truncate(chunk);
+    sizes.clear();
+    REQUIRE(segments_of(buffer, sizes) == std::string(chunk, 'a'));
+    REQUIRE(sizes == std::vector<size_t>{ chunk });
+
+    buffer.clear();
+    REQUIRE(buffer.empty());
+    sizes.clear();
+    REQUIRE(segments_of(buffer, sizes).empty());
+    REQUIRE(sizes.empty());
+}
+
+TEST_CASE("text_writer,swap")
+{
+    // swap() moves the body aside so that a preamble written afterwards comes first in the output.
+    test_writer w;
+    std::string const body(chunked_buffer::chunk_size * 2 + 5, 'b');
+    w.write(body);
+    w.swap();
+    w.write("preamble %\n", 1);
+    REQUIRE(w.bytes_written() == body.size() + 11);
+    REQUIRE(w.flush_to_string() == "preamble 1\n" + body);
+    REQUIRE(w.flush_to_string().empty());
+}
+
+TEST_CASE("text_writer,format")
+{
+    test_writer w;
+    w.write("% % ^% ^@ ^^ %", "a", 'b', 3);
+    static constexpr char format[] = "[%]";
+    w.write(format, std::string_view{ "named" });
+    std::string_view const runtime = "<%>";
+    w.write(runtime, "runtime");
+    REQUIRE(w.flush_to_string() == "a b % @ ^ 3[named]<runtime>");
+
+    REQUIRE(w.write_temp("%.%", "impl", 'x') == "impl.x");
+    REQUIRE(w.flush_to_string().empty());
+
+    static_assert(is_valid_format<2, two_placeholders>);
+    static_assert(!is_valid_format<1, two_placeholders>);
+    static_assert(!is_valid_format<3, two_placeholders>);
+    static_assert(is_valid_format<1, escaped_placeholder>);
+    static_assert(!is_valid_format<2, escaped_placeholder>);
+}
+
+TEST_CASE("text_writer,flush_to_file")
+{
+    temp_directory temp;
+    auto const filename = (temp.path / "output.h").string();
+    std::string const content(chunked_buffer::chunk_size + 100, 'x');
+    auto const old_time = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+
+    test_writer w;
+    w.write(content);
+    w.flush_to_file(filename);
+    REQUIRE(file_to_string(filename) == content);
+
+    // Unchanged output leaves the existing file alone.
+    std::filesystem::last_write_time(filename, old_time);
+    w.write(content);
+    w.flush_to_file(filename);
+    REQUIRE(std::filesystem::last_write_time(filename) == old_time);
+
+    // Changed output of the same size replaces the file.
+    std::string changed = content;
+    changed.back() = 'y';
+    w.write(changed);
+    w.flush_to_file(filename);
+    REQUIRE(std::filesystem::last_write_time(filename) != old_time);
+    REQUIRE(file_to_string(filename) == changed);
+
+    // The temporary file used for the replacement is gone.
+    REQUIRE(std::distance(std::filesystem::directory_iterator(temp.path), std::filesystem::directory_iterator()) == 1);
+}
@@ -0,0 +1,149 @@
+#include "pch.h"
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <numeric>
+
+using namespace winrt;
+using namespace Windows::Foundation::Collections;
+
+namespace
+{
+    // A forward-only container with no size() of its own, so the view has to measure it.
+    struct forward_container
+    {
+        std::forward_list<int> values;
+
+        auto begin() const noexcept
+        {
+            return values.begin();
+        }
+
+        auto end() const noexcept
+        {
+            return values.end();
+        }
+    };
+
+    template <typename Container>
+    IVectorView<int> make_view(std::vector<int> const& values)
+    {
+        if constexpr (std::is_same_v<Container, forward_container>)
+        {
+            return make<impl::input_vector_view<int, forward_container>>(forward_container{ { values.begin(), values.end() } });
+        }
+        else
+        {
+            return make<impl::input_vector_view<int, Container>>(Container(values.begin(), values.end()));
+        }
+    }
+
+    template <typename Container>
+    void test_access()
+    {
+        std::vector<int> const values{ 1, 2, 3, 4, 5 };
+        auto view = make_view<Container>(values);
+
+        REQUIRE(view.Size() == 5);
+        REQUIRE(view.GetAt(0) == 1);
+        REQUIRE(view.GetAt(4) == 5);
+        REQUIRE_THROWS_AS(view.GetAt(5), hresult_out_of_bounds);
+
+        uint32_t index{};
+        REQUIRE(view.IndexOf(3, index));
+        REQUIRE(index == 2);
+        REQUIRE(!view.IndexOf(6, index));
+        REQUIRE(index == 5);
+
+        std::array<int, 3> many{};
+        REQUIRE(view.GetMany(3, many) == 2);
+        REQUIRE(many[0] == 4);
+        REQUIRE(many[1] == 5);
+        REQUIRE(view.GetMany(5, many) == 0);
+
+        std::vector<int> iterated;
+
+        for (auto&& value : view)
+        {
+            iterated.push_back(value);
+        }
+
+        REQUIRE(iterated == values);
+    }
+
+    template <typename Container>
+    int64_t measure(char const* name, uint32_t const count)
+    {
+        std::vector<int> values(count);
+        std::iota(values.begin(), values.end(), 0);
+        auto view = make_view<Container>(values);
+        int64_t total{};
+
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            total += view.GetAt(index);
+        }
+
+        auto const get_at = std::chrono::high_resolution_clock::now();
+        std::vector<int> many(64);
+
+        for (uint32_t index = 0; index < count; index += static_cast<uint32_t>(many.size()))
+        {
+            total += view.GetMany(index, many);
+        }
+
+        auto const get_many = std::chrono::high_resolution_clock::now();
+        uint32_t found{};
+
+        for (uint32_t index = 0; index < 100; ++index)
+        {
+            REQUIRE(view.IndexOf(static_cast<int>(count - 1 - index), found));
+            total += found;
+        }
+
+        auto const index_of = std::chrono::high_resolution_clock::now();
+
+        WARN(name << " (" << count << "): GetAt "
+            << std::chrono::duration_cast<std::chrono::microseconds>(get_at - start).count() << "us, GetMany "
+            << std::chrono::duration_cast<std::chrono::microseconds>(get_many - get_at).count() << "us, IndexOf "
+            << std::chrono::duration_cast<std::chrono::microseconds>(index_of - get_many).count() << "us");
+
+        return total;
+    }
+}
+
+TEST_CASE("vector_view_access")
+{
+    test_access<std::vector<int>>();
+    test_access<std::deque<int>>();
+    test_access<std::list<int>>();
+    test_access<forward_container>();
+}
+
+TEST_CASE("vector_view_access,scoped")
+{
+    std::list<int> const values{ 1, 2, 3 };
+    param::vector_view<int> param(values.begin(), values.end());
+    IVectorView<int> const& view = param;
+
+    REQUIRE(view.Size() == 3);
+    REQUIRE(view.GetAt(2) == 3);
+
+    std::array<int, 2> many{};
+    REQUIRE(view.GetMany(1, many) == 2);
+    REQUIRE(many[0] == 2);
+    REQUIRE(many[1] == 3);
+}
+
+TEST_CASE("vector_view_access,benchmark", "[.benchmark]")
+{
+    for (uint32_t count : { 1'000, 10'000 })
+    {
+        REQUIRE(measure<std::vector<int>>("vector", count) != 0);
+        REQUIRE(measure<std::deque<int>>("deque", count) != 0);
+        REQUIRE(measure<std::list<int>>("list", count) != 0);
+        REQUIRE(measure<forward_container>("forward_list", count) != 0);
+    }
+}
@@ -92,4 +92,31 @@ TEST_CASE("when")
 
         SetEvent(first_event.get());
     }
+    {
+        handle first_event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+        handle second_event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+        handle completed{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+
+        IAsyncOperation<int> first = when_signaled(1, first_event);
+        IAsyncOperation<int> second = when_signaled(2, second_event);
+
+        IAsyncOperation<int> result = when_any(first, second);
+        result.Completed([&](auto&&, AsyncStatus status)
+        {
+            REQUIRE(status == AsyncStatus::Canceled);
+            SetEvent(completed.get());
+        });
+
+        // Canceling when_any resumes it without waiting for any of the async objects, which are left running.
+        result.Cancel();
+        REQUIRE(WaitForSingleObject(completed.get(), 5000) == WAIT_OBJECT_0);
+        REQUIRE_THROWS_AS(result.GetResults(), hresult_canceled);
+        REQUIRE(first.Status() == AsyncStatus::Started);
+        REQUIRE(second.Status() == AsyncStatus::Started);
+
+        SetEvent(first_event.get());
+        SetEvent(second_event.get());
+        REQUIRE(first.get() == 1);
+        REQUIRE(second.get() == 2);
+    }
 }
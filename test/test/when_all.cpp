@@ -0,0 +1,188 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    IAsyncOperation<int> Value(int value)
+    {
+        co_await resume_background();
+        co_return value;
+    }
+
+    IAsyncOperation<int> Signaled(int value, handle const& event)
+    {
+        co_await resume_on_signal(event.get());
+        co_return value;
+    }
+
+    IAsyncOperation<int> Failure()
+    {
+        co_await resume_background();
+        throw hresult_invalid_argument(L"when_all");
+    }
+
+    IAsyncAction Action(std::atomic<uint32_t>& counter)
+    {
+        co_await resume_background();
+        ++counter;
+    }
+
+    IAsyncOperation<int> Sum(std::vector<IAsyncOperation<int>> async)
+    {
+        int sum{};
+
+        for (int value : co_await when_all(async))
+        {
+            sum += value;
+        }
+
+        co_return sum;
+    }
+
+    IAsyncOperation<int> SumSequential(std::vector<IAsyncOperation<int>> async)
+    {
+        int sum{};
+
+        for (auto&& operation : async)
+        {
+            sum += co_await operation;
+        }
+
+        co_return sum;
+    }
+
+    IAsyncOperation<uint32_t> RunActions(uint32_t const count)
+    {
+        std::atomic<uint32_t> counter{};
+        std::vector<IAsyncAction> async;
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            async.push_back(Action(counter));
+        }
+
+        co_await when_all(async);
+        co_return counter.load();
+    }
+
+    IAsyncOperation<int> WaitForFailure(std::vector<IAsyncOperation<int>> async)
+    {
+        co_await when_all(async);
+        co_return 0;
+    }
+
+    std::vector<IAsyncOperation<int>> make_values(int const count)
+    {
+        std::vector<IAsyncOperation<int>> async;
+
+        for (int index = 0; index < count; ++index)
+        {
+            async.push_back(Value(index));
+        }
+
+        return async;
+    }
+
+    // Returns the average time in microseconds taken to await the given number of operations.
+    template <typename F>
+    int64_t measure(int const count, F const& sum)
+    {
+        uint32_t const rounds = 10'000 / count + 10;
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t round = 0; round < rounds; ++round)
+        {
+            REQUIRE(sum(make_values(count)).get() == count * (count - 1) / 2);
+        }
+
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count() / rounds;
+    }
+}
+
+TEST_CASE("when_all,range")
+{
+    // Results are produced in the order of the range, not the order of completion.
+    handle first_event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    handle second_event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    std::vector<IAsyncOperation<int>> async{ Signaled(1, first_event), Signaled(2, second_event), Value(3) };
+
+    auto results = [](std::vector<IAsyncOperation<int>> async) -> IAsyncOperation<hstring>
+    {
+        std::wstring text;
+
+        for (int value : co_await when_all(async))
+        {
+            text += std::to_wstring(value);
+        }
+
+        co_return hstring{ text };
+    }(async);
+
+    Sleep(100);
+    REQUIRE(results.Status() == AsyncStatus::Started);
+    SetEvent(second_event.get());
+    Sleep(100);
+    REQUIRE(results.Status() == AsyncStatus::Started);
+    SetEvent(first_event.get());
+    REQUIRE(results.get() == L"123");
+
+    REQUIRE(Sum(make_values(100)).get() == 4950);
+    REQUIRE(RunActions(100).get() == 100);
+
+    // An empty range completes immediately.
+    REQUIRE(Sum({}).get() == 0);
+    REQUIRE(RunActions(0).get() == 0);
+}
+
+TEST_CASE("when_all,pack")
+{
+    std::atomic<uint32_t> counter{};
+    when_all(Action(counter), Action(counter), Action(counter)).get();
+    REQUIRE(counter == 3);
+
+    when_all(Value(1), Action(counter)).get();
+    REQUIRE(counter == 4);
+}
+
+TEST_CASE("when_all,failure")
+{
+    // The coroutine resumes only once every operation has completed, and then rethrows the first failure.
+    handle event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    IAsyncOperation<int> pending = Signaled(1, event);
+    IAsyncOperation<int> failed = WaitForFailure({ Value(1), Failure(), pending });
+
+    Sleep(100);
+    REQUIRE(failed.Status() == AsyncStatus::Started);
+    SetEvent(event.get());
+
+    REQUIRE_THROWS_AS(failed.get(), hresult_invalid_argument);
+    REQUIRE(pending.Status() == AsyncStatus::Completed);
+
+    REQUIRE_THROWS_AS(when_all(Value(1), Failure()).get(), hresult_invalid_argument);
+}
+
+TEST_CASE("when_all,cancel")
+{
+    // Canceling the awaiting coroutine cancels the operations it waits for.
+    handle event{ check_pointer(CreateEventW(nullptr, true, false, nullptr)) };
+    IAsyncOperation<int> pending = Signaled(1, event);
+    IAsyncOperation<int> waiting = WaitForFailure({ pending, Value(2) });
+
+    Sleep(100);
+    waiting.Cancel();
+
+    REQUIRE_THROWS_AS(waiting.get(), hresult_canceled);
+    REQUIRE(pending.Status() == AsyncStatus::Canceled);
+}
+
+TEST_CASE("when_all,benchmark", "[.benchmark]")
+{
+    for (int count : { 10, 100, 1000 })
+    {
+        auto const sequential = measure(count, SumSequential);
+        auto const counted = measure(count, Sum);
+        WARN(count << " operations: sequential " << sequential << "us, when_all " << counted << "us");
+    }
+}
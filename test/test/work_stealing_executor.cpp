@@ -0,0 +1,195 @@
+#include "pch.h"
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    std::atomic<uint32_t> counter{};
+
+    void __stdcall count(void*, void*) noexcept
+    {
+        ++counter;
+    }
+
+    void wait_for_count(uint32_t const expected)
+    {
+        while (counter < expected)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    IAsyncOperation<uint32_t> Hops(work_stealing_executor& executor, uint32_t const hops)
+    {
+        co_await executor;
+        uint32_t same{};
+
+        for (uint32_t hop = 0; hop < hops; ++hop)
+        {
+            auto const before = GetCurrentThreadId();
+            co_await resume_background();
+
+            if (before == GetCurrentThreadId())
+            {
+                ++same;
+            }
+        }
+
+        co_return same;
+    }
+
+    IAsyncAction Chain(uint32_t const hops)
+    {
+        for (uint32_t hop = 0; hop < hops; ++hop)
+        {
+            co_await resume_background();
+        }
+    }
+
+    fire_and_forget HopAndBlock(work_stealing_executor& executor, std::atomic<bool>& done)
+    {
+        co_await executor;
+
+        // The continuation goes to this thread's LIFO slot and the thread then blocks waiting for it, so another
+        // thread must take it.
+        Chain(1).get();
+        done = true;
+    }
+
+    // Returns the time in milliseconds taken by the given number of coroutines that each hop to the background the
+    // given number of times.
+    int64_t measure_hops(uint32_t const coroutines, uint32_t const hops)
+    {
+        std::vector<IAsyncAction> chains;
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < coroutines; ++index)
+        {
+            chains.push_back(Chain(hops));
+        }
+
+        for (auto&& chain : chains)
+        {
+            chain.get();
+        }
+
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+TEST_CASE("work_stealing_executor")
+{
+    counter = 0;
+
+    {
+        work_stealing_executor executor(4);
+        REQUIRE(executor.thread_count() == 4);
+
+        for (uint32_t index = 0; index < 10'000; ++index)
+        {
+            executor.submit(count, nullptr);
+        }
+
+        wait_for_count(10'000);
+
+        std::vector<executor_work> batch(1'000, executor_work{ count, nullptr });
+        executor.submit(batch);
+        wait_for_count(11'000);
+
+        // Work queued when the executor is destroyed still runs.
+        executor.submit(batch);
+    }
+
+    REQUIRE(counter == 12'000);
+}
+
+TEST_CASE("work_stealing_executor,resume_background")
+{
+    REQUIRE(!winrt_resume_background_handler);
+
+    {
+        work_stealing_executor executor(2);
+        executor.make_default();
+        REQUIRE(winrt_resume_background_handler);
+
+        // Continuations submitted from the executor's threads run on the same thread, unless another has stolen them.
+        auto const same = Hops(executor, 1'000).get();
+        REQUIRE(same > 0);
+
+        std::atomic<uint32_t> done{};
+        Chain(100).Completed([&](auto&&...) { ++done; });
+        Chain(100).get();
+
+        while (done == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Destroying the default executor routes resume_background back to the thread pool.
+    REQUIRE(!winrt_resume_background_handler);
+    Chain(10).get();
+}
+
+TEST_CASE("work_stealing_executor,blocking")
+{
+    work_stealing_executor executor(2);
+    executor.make_default();
+    std::atomic<bool> done{};
+    HopAndBlock(executor, done);
+
+    auto const timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+    while (!done && std::chrono::steady_clock::now() < timeout)
+    {
+        std::this_thread::yield();
+    }
+
+    REQUIRE(done);
+}
+
+TEST_CASE("work_stealing_executor,destroy")
+{
+    // Work submitted while the default executor is being destroyed goes to the thread pool rather than being lost.
+    counter = 0;
+    std::atomic<bool> stop{};
+    std::atomic<uint32_t> submitted{};
+    std::thread submitter;
+
+    {
+        work_stealing_executor executor(2);
+        executor.make_default();
+
+        submitter = std::thread([&]
+        {
+            while (!stop)
+            {
+                impl::submit_threadpool_callback(count, nullptr);
+                ++submitted;
+            }
+        });
+
+        Sleep(20);
+    }
+
+    Sleep(5);
+    stop = true;
+    submitter.join();
+    wait_for_count(submitted);
+    REQUIRE(!winrt_resume_background_handler);
+}
+
+TEST_CASE("work_stealing_executor,benchmark", "[.benchmark]")
+{
+    auto const pool = measure_hops(64, 10'000);
+    WARN("thread pool: " << pool << "ms for 640000 hops");
+
+    for (uint32_t threads = 1; threads <= (std::max)(2u, std::thread::hardware_concurrency()); threads *= 2)
+    {
+        work_stealing_executor executor(threads);
+        executor.make_default();
+        auto const elapsed = measure_hops(64, 10'000);
+        WARN(threads << " threads: " << elapsed << "ms for 640000 hops");
+    }
+}
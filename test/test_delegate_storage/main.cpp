@@ -0,0 +1,227 @@
+#include <crtdbg.h>
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+#include <windows.h>
+#include "winrt/Windows.Foundation.h"
+
+// These tests replace the global operator new to count allocations, which affects every translation unit in a link and
+// every thread in the process, which is why they are tested by their own executable.
+
+using namespace winrt;
+using namespace Windows::Foundation;
+
+namespace
+{
+    std::atomic<uint64_t> allocations{};
+}
+
+void* operator new(size_t const size)
+{
+    ++allocations;
+
+    if (auto result = malloc(size ? size : 1))
+    {
+        return result;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const value) noexcept
+{
+    free(value);
+}
+
+namespace
+{
+    int total{};
+
+    struct pool_guard
+    {
+        pool_guard() noexcept
+        {
+            winrt_delegate_pool_enabled = true;
+        }
+
+        ~pool_guard() noexcept
+        {
+            winrt_delegate_pool_enabled = false;
+        }
+    };
+
+    struct sharing_guard
+    {
+        sharing_guard() noexcept
+        {
+            winrt_delegate_sharing_enabled = true;
+        }
+
+        ~sharing_guard() noexcept
+        {
+            winrt_delegate_sharing_enabled = false;
+        }
+    };
+
+    struct counter
+    {
+        int m_count{};
+
+        void add(int value)
+        {
+            m_count += value;
+        }
+    };
+
+    auto make_handler()
+    {
+        return [](int value) { total += value; };
+    }
+
+    // Returns the time in milliseconds taken to create, invoke and release the given number of delegates, and the
+    // number of allocations made.
+    std::pair<int64_t, uint64_t> measure_delegates(uint32_t const count)
+    {
+        counter object;
+        auto const before = allocations.load();
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t index = 0; index < count; ++index)
+        {
+            delegate<int> handler{ &object, &counter::add };
+            handler(1);
+        }
+
+        auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        REQUIRE(object.m_count == static_cast<int>(count));
+        return { elapsed, allocations - before };
+    }
+}
+
+TEST_CASE("delegate_storage,stateless")
+{
+    // By default, each registration of a handler without state gets a delegate and an event token of its own.
+    {
+        event<EventHandler<int>> source;
+        auto const handler = [](auto&&, int value) { total += value; };
+        auto const first = source.add(handler);
+        auto const second = source.add(handler);
+        REQUIRE(first.value != second.value);
+
+        total = 0;
+        source.remove(first);
+        source(nullptr, 1);
+        REQUIRE(total == 1);
+    }
+
+    // When sharing is enabled, delegates for a handler without state share a single instance, which holds the module
+    // lock only while it is referenced from outside.
+    sharing_guard guard;
+    uint32_t const locks = get_module_lock();
+    total = 0;
+    delegate<int> first = make_handler();
+    delegate<int> second = make_handler();
+    REQUIRE(get_abi(first) == get_abi(second));
+    REQUIRE(get_module_lock() == locks + 1);
+
+    auto const before = allocations.load();
+    delegate<int> third = make_handler();
+    third = nullptr;
+    REQUIRE(allocations == before);
+
+    first(1);
+    second(2);
+    REQUIRE(total == 3);
+
+    {
+        EventHandler<int> event_first = [](auto&&, int value) { total += value; };
+        EventHandler<int> event_copy = event_first;
+        event_copy(nullptr, 4);
+        REQUIRE(total == 7);
+    }
+
+    first = nullptr;
+    second(3);
+    REQUIRE(total == 10);
+
+    second = nullptr;
+    REQUIRE(get_module_lock() == locks);
+}
+
+TEST_CASE("delegate_storage,pool")
+{
+    pool_guard guard;
+    counter object;
+    void* released{};
+
+    {
+        delegate<int> handler{ &object, &counter::add };
+        handler(1);
+        released = get_abi(handler);
+    }
+
+    // The next delegate of the same size class created on this thread reuses the released one without allocating.
+    {
+        auto const before = allocations.load();
+        delegate<int> handler{ &object, &counter::add };
+        REQUIRE(allocations == before);
+        handler(2);
+        REQUIRE(get_abi(handler) == released);
+    }
+
+    REQUIRE(object.m_count == 3);
+
+    // A delegate created while the pool is disabled is allocated at its own size and does not join the cache when
+    // released, so the next pooled delegate allocates.
+    {
+        winrt_delegate_pool_enabled = false;
+        delegate<int> handler{ &object, &counter::add };
+        winrt_delegate_pool_enabled = true;
+        handler(1);
+    }
+
+    {
+        delegate<int> handler{ &object, &counter::add };
+        REQUIRE(get_abi(handler) == released);
+    }
+
+    {
+        delegate<int> first{ &object, &counter::add };
+        auto const before = allocations.load();
+        delegate<int> second{ &object, &counter::add };
+        REQUIRE(allocations == before + 1);
+    }
+
+    REQUIRE(object.m_count == 4);
+
+    // Handlers too large for the pool are allocated individually.
+    std::array<int, 1000> values{};
+    values[999] = 4;
+    delegate<int> large = [values, &object](int index) { object.add(values[index]); };
+    large(999);
+    REQUIRE(object.m_count == 8);
+}
+
+TEST_CASE("delegate_storage,benchmark", "[.benchmark]")
+{
+    uint32_t const count = 10'000'000;
+    auto const [heap, heap_allocations] = measure_delegates(count);
+
+    pool_guard guard;
+    auto const [pool, pool_allocations] = measure_delegates(count);
+    WARN(count << " delegates: heap " << heap << "ms, " << heap_allocations << " allocations, pool " << pool << "ms, " << pool_allocations << " allocations");
+}
+
+int main(int const argc, char** argv)
+{
+    std::set_terminate([] { reportFatal("Abnormal termination"); ExitProcess(1); });
+    _CrtSetReportMode(_CRT_ASSERT, _CRTDBG_MODE_FILE);
+    (void)_CrtSetReportFile(_CRT_ASSERT, _CRTDBG_FILE_STDERR);
+    _CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_FILE);
+    (void)_CrtSetReportFile(_CRT_ERROR, _CRTDBG_FILE_STDERR);
+    return Catch::Session().run(argc, argv);
+}
+
+CATCH_TRANSLATE_EXCEPTION(winrt::hresult_error const& e)
+{
+    return to_string(e.message());
+}
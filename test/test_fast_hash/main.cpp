@@ -0,0 +1,92 @@
+#include <crtdbg.h>
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+#include <windows.h>
+
+// Defining WINRT_FAST_HASH switches hash_data and std::hash<hstring> to a block-based hash. It must be defined the same
+// way in every translation unit in a link, which is why it is tested by its own executable.
+
+#define WINRT_FAST_HASH
+#include "winrt/Windows.Foundation.h"
+
+using namespace winrt;
+
+namespace
+{
+    size_t expected_hash(std::wstring_view const& value)
+    {
+        return static_cast<size_t>(impl::hash_data_fast(value.data(), sizeof(wchar_t) * value.size()));
+    }
+
+    hstring create_os_string(std::wstring_view const& value)
+    {
+        HSTRING raw{};
+        check_hresult(WindowsCreateString(value.data(), static_cast<uint32_t>(value.size()), &raw));
+        return { raw, take_ownership_from_abi };
+    }
+}
+
+TEST_CASE("fast_hash,hstring")
+{
+    std::hash<hstring> const hash;
+
+    // Strings created by C++/WinRT, by the OS and by reference all hash their characters the same way.
+    hstring const heap{ L"PropertyName" };
+    hstring const os = create_os_string(L"PropertyName");
+    param::hstring const reference{ std::wstring_view{ L"PropertyName" } };
+
+    REQUIRE(hash(heap) == expected_hash(L"PropertyName"));
+    REQUIRE(hash(os) == hash(heap));
+    REQUIRE(hash(static_cast<hstring const&>(reference)) == hash(heap));
+    REQUIRE(hash(hstring{}) == expected_hash({}));
+    REQUIRE(impl::hash_data(L"PropertyName", sizeof(wchar_t) * 12) == hash(heap));
+
+    // A string whose memory was used by an earlier string hashes its own characters, whoever created it.
+    for (uint32_t index = 0; index < 1000; ++index)
+    {
+        std::wstring const first = L"first" + std::to_wstring(index);
+        std::wstring const second = L"other" + std::to_wstring(index);
+
+        {
+            hstring value{ first };
+            REQUIRE(hash(value) == expected_hash(first));
+        }
+
+        hstring reused = index % 2 ? create_os_string(second) : hstring{ second };
+        REQUIRE(hash(reused) == expected_hash(second));
+    }
+}
+
+TEST_CASE("fast_hash,unordered_map")
+{
+    std::unordered_map<hstring, int> map;
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        map.emplace(L"key" + std::to_wstring(index), index);
+    }
+
+    for (int index = 0; index < 1000; ++index)
+    {
+        auto const key = L"key" + std::to_wstring(index);
+        REQUIRE(map.at(hstring{ key }) == index);
+        REQUIRE(map.at(create_os_string(key)) == index);
+    }
+
+    REQUIRE(map.find(hstring{ L"key1000" }) == map.end());
+}
+
+int main(int const argc, char** argv)
+{
+    std::set_terminate([] { reportFatal("Abnormal termination"); ExitProcess(1); });
+    _CrtSetReportMode(_CRT_ASSERT, _CRTDBG_MODE_FILE);
+    (void)_CrtSetReportFile(_CRT_ASSERT, _CRTDBG_FILE_STDERR);
+    _CrtSetReportMode(_CRT_ERROR, _CRTDBG_MODE_FILE);
+    (void)_CrtSetReportFile(_CRT_ERROR, _CRTDBG_FILE_STDERR);
+    return Catch::Session().run(argc, argv);
+}
+
+CATCH_TRANSLATE_EXCEPTION(winrt::hresult_error const& e)
+{
+    return to_string(e.message());
+}
@@ -0,0 +1,184 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "winrt/base.h"
+#include <malloc.h>
+#include <thread>
+
+// Stand-ins for the process heap functions, which count every allocation and free.
+
+namespace
+{
+    std::atomic<uint32_t> allocations{};
+    std::atomic<uint32_t> frees{};
+}
+
+extern "C" void* GetProcessHeap() noexcept
+{
+    return reinterpret_cast<void*>(1);
+}
+
+extern "C" void* HeapAlloc(void*, uint32_t, size_t bytes) noexcept
+{
+    ++allocations;
+    return malloc(bytes);
+}
+
+extern "C" int32_t HeapFree(void*, uint32_t, void* value) noexcept
+{
+    ++frees;
+    free(value);
+    return 1;
+}
+
+extern "C" size_t HeapSize(void*, uint32_t, void const* value) noexcept
+{
+    return malloc_usable_size(const_cast<void*>(value));
+}
+
+using namespace winrt;
+
+namespace
+{
+    struct pool_guard
+    {
+        pool_guard() noexcept
+        {
+            winrt_hstring_pool_enabled = true;
+        }
+
+        ~pool_guard() noexcept
+        {
+            winrt_hstring_pool_enabled = false;
+        }
+    };
+
+    // Creates a heap string the way another module might, leaving the header padding as whatever the memory held.
+    void* create_foreign_string(wchar_t const* value, size_t const bytes)
+    {
+        auto const length = static_cast<uint32_t>(wcslen(value));
+        REQUIRE(bytes >= sizeof(impl::shared_hstring_header) + sizeof(wchar_t) * length);
+        auto header = static_cast<impl::shared_hstring_header*>(HeapAlloc(GetProcessHeap(), 0, bytes));
+        memset(header, 0x70, bytes);
+        header->flags = 0;
+        header->length = length;
+        header->ptr = header->buffer;
+        header->count = 1;
+        memcpy(header->buffer, value, sizeof(wchar_t) * (length + 1));
+        return header;
+    }
+
+    // Returns a string whose heap string needs the given number of bytes.
+    std::wstring string_of_size(size_t const bytes)
+    {
+        return std::wstring((bytes - sizeof(impl::shared_hstring_header)) / sizeof(wchar_t), L'x');
+    }
+
+    void reset_counts()
+    {
+        allocations = 0;
+        frees = 0;
+    }
+}
+
+TEST_CASE("hstring_pool,disabled")
+{
+    reset_counts();
+
+    {
+        hstring value{ L"key" };
+        REQUIRE(value == L"key");
+    }
+
+    REQUIRE(allocations == 1);
+    REQUIRE(frees == 1);
+}
+
+TEST_CASE("hstring_pool")
+{
+    pool_guard guard;
+    reset_counts();
+    void* first{};
+
+    {
+        hstring value{ L"key" };
+        first = get_abi(value);
+    }
+
+    // The released block is cached rather than freed, and reused by the next string of the same size class.
+    REQUIRE(frees == 0);
+    hstring value{ L"other" };
+    REQUIRE(get_abi(value) == first);
+    REQUIRE(allocations == 1);
+
+    // Copies share the block, which is only cached once the last one is released.
+    hstring copy = value;
+    value = L"";
+    REQUIRE(copy == L"other");
+    REQUIRE(frees == 0);
+
+    // Strings larger than the largest size class come from the heap and go back to it.
+    {
+        hstring big{ std::wstring(1000, L'x') };
+    }
+
+    REQUIRE(allocations == 2);
+    REQUIRE(frees == 1);
+}
+
+TEST_CASE("hstring_pool,foreign")
+{
+    pool_guard guard;
+
+    // A block created elsewhere joins the largest size class its heap size can hold, whatever its padding contains.
+    void* foreign = create_foreign_string(L"foreign", 150);
+    reset_counts();
+
+    {
+        hstring value{ foreign, take_ownership_from_abi };
+        REQUIRE(value == L"foreign");
+    }
+
+    REQUIRE(frees == 0);
+
+    // A string needing the 128 byte class reuses it without allocating, while one needing 256 bytes does not.
+    std::wstring const medium = string_of_size(100);
+    hstring reused{ medium };
+    REQUIRE(get_abi(reused) == foreign);
+    REQUIRE(reused == medium);
+    REQUIRE(allocations == 0);
+
+    hstring large{ string_of_size(200) };
+    REQUIRE(get_abi(large) != foreign);
+    REQUIRE(allocations == 1);
+
+    // Blocks too small for the smallest class, or far larger than the largest, are freed.
+    reset_counts();
+    hstring small{ create_foreign_string(L"s", 40), take_ownership_from_abi };
+    hstring huge{ create_foreign_string(L"h", 4000), take_ownership_from_abi };
+    small = L"";
+    huge = L"";
+    REQUIRE(frees == 2);
+}
+
+TEST_CASE("hstring_pool,thread")
+{
+    pool_guard guard;
+
+    // Blocks cached by a thread are freed when it exits.
+    reset_counts();
+
+    std::thread([]
+    {
+        hstring value{ L"thread" };
+    }).join();
+
+    REQUIRE(allocations == 1);
+    REQUIRE(frees == 1);
+
+    // A pooled string released after the pool has been turned off goes back to the heap.
+    reset_counts();
+    hstring value{ L"pooled" };
+    winrt_hstring_pool_enabled = false;
+    value = L"";
+    REQUIRE(frees == 1);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+// Stand-ins for the MSVC keywords, intrinsics and secure CRT functions that winrt/base.h uses, so that the parts of
+// it that don't call into Windows can be compiled and tested with GCC or Clang on Linux.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+
+#define __stdcall
+#define __declspec(x)
+
+#ifndef _M_X64
+#define _M_X64 1
+#endif
+
+#define _ReadWriteBarrier() __asm__ __volatile__("" ::: "memory")
+
+inline long _InterlockedCompareExchange(long volatile* destination, long exchange, long comparand)
+{
+    return __sync_val_compare_and_swap(destination, comparand, exchange);
+}
+
+template <typename I>
+I _InterlockedIncrement(I volatile* value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
+
+template <typename I>
+I _InterlockedDecrement(I volatile* value)
+{
+    return __sync_sub_and_fetch(value, 1);
+}
+
+template <typename I>
+I _InterlockedIncrement64(I volatile* value)
+{
+    return __sync_add_and_fetch(value, 1);
+}
+
+template <typename I>
+I _InterlockedDecrement64(I volatile* value)
+{
+    return __sync_sub_and_fetch(value, 1);
+}
+
+template <typename I, typename X>
+I _InterlockedCompareExchange64(I volatile* destination, X exchange, I comparand)
+{
+    return __sync_val_compare_and_swap(destination, comparand, static_cast<I>(exchange));
+}
+
+inline void* _InterlockedCompareExchangePointer(void* volatile* destination, void* exchange, void* comparand)
+{
+    return __sync_val_compare_and_swap(destination, comparand, exchange);
+}
+
+inline unsigned char _InterlockedCompareExchange128(long long volatile* destination, long long high, long long low, long long* comparand)
+{
+    __int128 expected;
+    std::memcpy(&expected, comparand, sizeof(expected));
+    __int128 const exchange = (static_cast<__int128>(high) << 64) | static_cast<unsigned long long>(low);
+    __int128 const original = __sync_val_compare_and_swap(reinterpret_cast<__int128 volatile*>(destination), expected, exchange);
+    std::memcpy(comparand, &original, sizeof(original));
+    return original == expected;
+}
+
+inline int memcpy_s(void* destination, size_t, void const* source, size_t count)
+{
+    std::memcpy(destination, source, count);
+    return 0;
+}
+
+template <size_t N, typename... Args>
+int swprintf_s(wchar_t (&buffer)[N], wchar_t const* format, Args... args)
+{
+    return std::swprintf(buffer, N, format, args...);
+}
+
+template <typename... Args>
+int swprintf_s(wchar_t* buffer, size_t size, wchar_t const* format, Args... args)
+{
+    return std::swprintf(buffer, size, format, args...);
+}
@@ -0,0 +1,312 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include "winrt/base.h"
+#include <malloc.h>
+#include <thread>
+
+// Stand-ins for the process heap, for the slim reader/writer locks and condition variables, which count every wake,
+// and for the thread pool, which runs each callback on a thread of its own.
+
+namespace
+{
+    std::atomic<uint32_t> wakes{};
+    std::atomic<uint32_t> pool_callbacks{};
+
+    std::atomic<intptr_t>& srw_state(void* lock) noexcept
+    {
+        return *static_cast<std::atomic<intptr_t>*>(lock);
+    }
+
+    std::atomic<intptr_t>& condition_generation(void* cv) noexcept
+    {
+        return *static_cast<std::atomic<intptr_t>*>(cv);
+    }
+}
+
+extern "C" void* GetProcessHeap() noexcept
+{
+    return reinterpret_cast<void*>(1);
+}
+
+extern "C" void* HeapAlloc(void*, uint32_t, size_t bytes) noexcept
+{
+    return malloc(bytes);
+}
+
+extern "C" int32_t HeapFree(void*, uint32_t, void* value) noexcept
+{
+    free(value);
+    return 1;
+}
+
+extern "C" size_t HeapSize(void*, uint32_t, void const* value) noexcept
+{
+    return malloc_usable_size(const_cast<void*>(value));
+}
+
+extern "C" void RoFailFastWithErrorContext(int32_t) noexcept
+{
+    abort();
+}
+
+extern "C" uint8_t TryAcquireSRWLockExclusive(void* lock) noexcept
+{
+    intptr_t expected{};
+    return srw_state(lock).compare_exchange_strong(expected, -1);
+}
+
+extern "C" uint8_t TryAcquireSRWLockShared(void* lock) noexcept
+{
+    intptr_t value = srw_state(lock).load();
+    return value >= 0 && srw_state(lock).compare_exchange_strong(value, value + 1);
+}
+
+extern "C" void AcquireSRWLockExclusive(void* lock) noexcept
+{
+    while (!TryAcquireSRWLockExclusive(lock))
+    {
+        std::this_thread::yield();
+    }
+}
+
+extern "C" void AcquireSRWLockShared(void* lock) noexcept
+{
+    while (!TryAcquireSRWLockShared(lock))
+    {
+        std::this_thread::yield();
+    }
+}
+
+extern "C" void ReleaseSRWLockExclusive(void* lock) noexcept
+{
+    srw_state(lock).store(0);
+}
+
+extern "C" void ReleaseSRWLockShared(void* lock) noexcept
+{
+    srw_state(lock).fetch_sub(1);
+}
+
+extern "C" int32_t SleepConditionVariableSRW(void* cv, void* lock, uint32_t const milliseconds, uint32_t) noexcept
+{
+    auto& generation = condition_generation(cv);
+    intptr_t const before = generation.load();
+    ReleaseSRWLockExclusive(lock);
+    bool woken = true;
+
+    if (milliseconds == 0xFFFFFFFF)
+    {
+        generation.wait(before);
+    }
+    else
+    {
+        auto const until = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+
+        while (generation.load() == before)
+        {
+            if (std::chrono::steady_clock::now() >= until)
+            {
+                woken = false;
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    AcquireSRWLockExclusive(lock);
+    return woken;
+}
+
+extern "C" void WakeConditionVariable(void* cv) noexcept
+{
+    ++wakes;
+    ++condition_generation(cv);
+    condition_generation(cv).notify_one();
+}
+
+extern "C" void WakeAllConditionVariable(void* cv) noexcept
+{
+    ++wakes;
+    ++condition_generation(cv);
+    condition_generation(cv).notify_all();
+}
+
+extern "C" int32_t TrySubmitThreadpoolCallback(void(*callback)(void*, void*), void* context, void*) noexcept
+{
+    ++pool_callbacks;
+    std::thread([=] { callback(nullptr, context); }).detach();
+    return 1;
+}
+
+extern "C" uint32_t GetLastError() noexcept
+{
+    return 0;
+}
+
+using namespace winrt;
+
+namespace
+{
+    std::atomic<uint32_t> counter{};
+
+    void __stdcall count(void*, void*) noexcept
+    {
+        ++counter;
+    }
+
+    void wait_for_count(uint32_t const expected)
+    {
+        while (counter < expected)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Hops onto the executor and then back onto it the given number of times, counting the hops that continued on
+    // the same thread.
+    fire_and_forget Hops(work_stealing_executor& executor, uint32_t const hops, uint32_t& same, std::atomic<bool>& done)
+    {
+        co_await executor;
+
+        for (uint32_t hop = 0; hop < hops; ++hop)
+        {
+            auto const before = std::this_thread::get_id();
+            co_await executor;
+
+            if (before == std::this_thread::get_id())
+            {
+                ++same;
+            }
+        }
+
+        done = true;
+    }
+
+    void wait_until(std::atomic<bool> const& done)
+    {
+        auto const timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (!done && std::chrono::steady_clock::now() < timeout)
+        {
+            std::this_thread::yield();
+        }
+
+        REQUIRE(done);
+    }
+}
+
+TEST_CASE("work_stealing_executor")
+{
+    counter = 0;
+
+    {
+        work_stealing_executor executor(4);
+        REQUIRE(executor.thread_count() == 4);
+
+        for (uint32_t index = 0; index < 10'000; ++index)
+        {
+            executor.submit(count, nullptr);
+        }
+
+        wait_for_count(10'000);
+
+        std::vector<executor_work> batch(1'000, executor_work{ count, nullptr });
+        executor.submit(batch);
+        wait_for_count(11'000);
+
+        // Work queued when the executor is destroyed still runs.
+        executor.submit(batch);
+    }
+
+    REQUIRE(counter == 12'000);
+}
+
+TEST_CASE("work_stealing_executor,lifo")
+{
+    work_stealing_executor executor(4);
+    uint32_t same{};
+    std::atomic<bool> done{};
+
+    // Continuations submitted from the executor's threads go to the LIFO slot, which neither wakes another thread
+    // nor is stolen while the thread that submitted it keeps running callbacks.
+    wakes = 0;
+    Hops(executor, 10'000, same, done);
+    wait_until(done);
+    REQUIRE(same > 9'000);
+    REQUIRE(wakes < 1'000);
+}
+
+TEST_CASE("work_stealing_executor,blocking")
+{
+    work_stealing_executor executor(2);
+    std::atomic<bool> ran{};
+    std::atomic<bool> done{};
+
+    struct context_type
+    {
+        work_stealing_executor& executor;
+        std::atomic<bool>& ran;
+        std::atomic<bool>& done;
+    } context{ executor, ran, done };
+
+    // The callback submits work to its own LIFO slot and then blocks waiting for it, so another thread must take it.
+    executor.submit([](void*, void* parameter) noexcept
+    {
+        auto& context = *static_cast<context_type*>(parameter);
+
+        context.executor.submit([](void*, void* parameter) noexcept
+        {
+            static_cast<std::atomic<bool>*>(parameter)->store(true);
+        }, &context.ran);
+
+        auto const timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+
+        while (!context.ran && std::chrono::steady_clock::now() < timeout)
+        {
+            std::this_thread::yield();
+        }
+
+        context.done = true;
+    }, &context);
+
+    wait_until(done);
+    REQUIRE(ran);
+}
+
+TEST_CASE("work_stealing_executor,destroy")
+{
+    // Work submitted while the default executor is being destroyed goes to the thread pool rather than being lost.
+    counter = 0;
+    pool_callbacks = 0;
+    std::atomic<bool> stop{};
+    std::atomic<uint32_t> submitted{};
+    std::thread submitter;
+
+    {
+        work_stealing_executor executor(2);
+        executor.make_default();
+        REQUIRE(winrt_resume_background_handler);
+
+        submitter = std::thread([&]
+        {
+            while (!stop)
+            {
+                impl::submit_threadpool_callback(count, nullptr);
+                ++submitted;
+            }
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    REQUIRE(!winrt_resume_background_handler);
+    impl::submit_threadpool_callback(count, nullptr);
+    ++submitted;
+    REQUIRE(pool_callbacks > 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    stop = true;
+    submitter.join();
+    wait_for_count(submitted);
+}
@@ -55,6 +55,18 @@ TEST_CASE("module_lock_none")
 
     REQUIRE(first == second);
 
+    // Validates that factories cached by name are still released by clear_factory_cache, since they are only cached on
+    // request.
+
+    {
+        auto const name = winrt::name_of<winrt::Windows::System::Diagnostics::SystemDiagnosticInfo>();
+        auto factory = winrt::get_cached_activation_factory(name);
+        REQUIRE(factory == winrt::get_cached_activation_factory(name));
+        winrt::clear_factory_cache();
+        REQUIRE(factory != winrt::get_cached_activation_factory(name));
+        winrt::clear_factory_cache();
+    }
+
     // Validates that test_component_base is pinned by virtue of it defining WINRT_NO_MODULE_LOCK.
 
 #ifdef __clang__